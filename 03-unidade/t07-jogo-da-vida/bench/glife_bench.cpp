@@ -0,0 +1,307 @@
+/*!
+ * Microbenchmarks of the Life board: stepping, text output and images.
+ * @file glife_bench.cpp
+ *
+ * Each case runs a few warmup iterations, calibrates how many iterations
+ * fill a sample of at least `min_sample_ms`, and then times a number of
+ * samples, reporting the median and the 99th percentile of the time per
+ * iteration along with the generations (or frames) and cells per second.
+ * The engine, threads and colors come from the configuration file, so the
+ * engines are compared by running the benchmark with different files.
+ *
+ * The `encode_png/` cases time the original RGBA `LifeCfg::encode_png()`,
+ * kept as the reference; the `png_encoder/` cases time the `PngEncoder` the
+ * image writer uses, with the color mode and deflate settings of the
+ * configuration, and also report the bytes of each frame.
+ *
+ * The `load/` cases read a synthetic .dat pattern of `load_size` cells of
+ * side, both with the memory-mapped loader and with the original one, which
+ * read every line into a vector of strings and then visited each character.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "frame.h"
+#include "life.h"
+#include "png_encoder.h"
+
+using namespace life;
+
+namespace {
+
+/// Options of a benchmark run.
+struct BenchOptions {
+  std::string settings{ "config/glife.ini" };  //!< Configuration file.
+  size_t max_size{ 8192 };                     //!< Largest board side.
+  size_t load_size{ 10000 };                   //!< Side of the pattern loaded by the load cases, zero to skip them.
+  size_t warmup{ 2 };                          //!< Untimed iterations before the samples.
+  size_t repetitions{ 15 };                    //!< Timed samples of each case.
+  double min_sample_ms{ 20 };                  //!< Minimum duration of a sample.
+  std::string filter;                          //!< Only the cases whose name contains it, empty for all.
+};
+
+/// A benchmark case: a body run once per iteration and the cells it processes.
+struct BenchCase {
+  std::string name;            //!< Name of the case.
+  size_t cells;                //!< Cells processed by each iteration.
+  std::function<void()> body;  //!< One iteration.
+  const size_t* bytes{ nullptr };  //!< Bytes produced by the last iteration, reported when set.
+};
+
+/// Duration of a number of iterations of a case, in nanoseconds.
+double time_iterations(const BenchCase& bench, size_t iterations) {
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; ++i) { bench.body(); }
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*!
+ * Value of a percentile of sorted samples, by the nearest rank.
+ * @param sorted The samples, in increasing order.
+ * @param percentile The percentile, in (0, 100].
+ * @return The sample at the percentile.
+ */
+double percentile(const std::vector<double>& sorted, double percentile) {
+  const auto rank = static_cast<size_t>(std::ceil(percentile / 100.0 * static_cast<double>(sorted.size())));
+  return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+/*!
+ * Runs a case and prints a line with its results.
+ * @param bench The case.
+ * @param options Warmup, repetitions and sample duration.
+ */
+void run_case(const BenchCase& bench, const BenchOptions& options) {
+  time_iterations(bench, options.warmup);
+
+  /// Double the iterations of a sample until it lasts long enough to be timed.
+  size_t iterations = 1;
+  const double min_sample_ns = options.min_sample_ms * 1e6;
+  while (time_iterations(bench, iterations) < min_sample_ns && iterations < (size_t{ 1 } << 20)) { iterations *= 2; }
+
+  std::vector<double> samples(options.repetitions);  //!<- Nanoseconds per iteration of each sample.
+  for (auto& sample : samples) { sample = time_iterations(bench, iterations) / static_cast<double>(iterations); }
+  std::sort(samples.begin(), samples.end());
+
+  const double median = percentile(samples, 50);
+  std::cout << std::left << std::setw(28) << bench.name << std::right << std::setw(10) << iterations
+            << std::fixed << std::setprecision(3) << std::setw(14) << median / 1e6 << std::setw(14)
+            << percentile(samples, 99) / 1e6 << std::setprecision(1) << std::setw(14) << 1e9 / median
+            << std::setw(14) << static_cast<double>(bench.cells) * 1e3 / median << std::defaultfloat;
+  if (bench.bytes != nullptr) { std::cout << std::setw(12) << *bench.bytes << " B"; }
+  std::cout << std::endl;
+}
+
+/*!
+ * Fills a board with random cells, always the same ones for a side and density.
+ * @param cfg The board.
+ * @param density Fraction of alive cells.
+ */
+void randomize(LifeCfg& cfg, double density) {
+  std::mt19937 random(static_cast<unsigned>(cfg.m_rows * 31 + static_cast<size_t>(density * 100)));
+  std::bernoulli_distribution alive(density);
+  for (size_t r = 1; r <= cfg.m_rows; ++r) {
+    for (size_t c = 1; c <= cfg.m_cols; ++c) { cfg.set_alive(r, c, alive(random)); }
+  }
+}
+
+/*!
+ * Writes a .dat pattern with random cells.
+ * @param filename Name of the pattern file.
+ * @param side Rows and columns of the pattern.
+ * @return true if the file was written, false otherwise.
+ */
+bool write_pattern(const std::string& filename, size_t side) {
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  std::mt19937 random(static_cast<unsigned>(side));
+  std::bernoulli_distribution alive(0.3);
+  std::string line(side, '.');
+
+  file << side << " " << side << "\n*\n";
+  for (size_t r = 0; r < side; ++r) {
+    for (auto& c : line) { c = alive(random) ? '*' : '.'; }
+    file << line << '\n';
+  }
+  return static_cast<bool>(file);
+}
+
+/*!
+ * Loads a .dat pattern the way LifeCfg did before the memory-mapped loader:
+ * every line is read into a vector of strings, and then every character of
+ * each row is visited through update_row_from_file().
+ * @param cfg The board.
+ * @param filename Name of the pattern file.
+ */
+void load_lines(LifeCfg& cfg, const std::string& filename) {
+  std::streambuf* const out = std::cout.rdbuf(nullptr);  //!<- read_file_info() reports on the standard output.
+  const std::vector<std::string> lines = LifeCfg::read_file_info(filename);
+  std::cout.rdbuf(out);
+
+  char alive_char = ' ';
+  for (size_t line_count = 0; line_count < lines.size(); ++line_count) {
+    const std::string& line = lines[line_count];
+    if (line_count == 0) {
+      cfg.m_rows = std::stoul(line);
+      cfg.m_cols = std::stoul(line.substr(line.find(' ') + 1));
+      cfg.fill_board();
+    } else if (line_count == 1) {
+      alive_char = line[0];
+    } else {
+      const size_t row = line_count - 1;
+      if (row > cfg.m_rows) { break; }
+      cfg.update_row_from_file(line, alive_char, row, cfg.m_cols);
+    }
+  }
+}
+
+/// Reads the options from the command line, returning false if one is not valid.
+bool parse_options(int argc, char* argv[], BenchOptions& options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--max-size" && has_value) { options.max_size = std::strtoul(argv[++i], nullptr, 10); }
+    else if (arg == "--load-size" && has_value) { options.load_size = std::strtoul(argv[++i], nullptr, 10); }
+    else if (arg == "--warmup" && has_value) { options.warmup = std::strtoul(argv[++i], nullptr, 10); }
+    else if (arg == "--repetitions" && has_value) { options.repetitions = std::strtoul(argv[++i], nullptr, 10); }
+    else if (arg == "--min-time" && has_value) { options.min_sample_ms = std::strtod(argv[++i], nullptr); }
+    else if (arg == "--filter" && has_value) { options.filter = argv[++i]; }
+    else if (arg.rfind("--", 0) != 0) { options.settings = arg; }
+    else { return false; }
+  }
+  return options.repetitions > 0 && options.min_sample_ms >= 0;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  BenchOptions options;
+  if (!parse_options(argc, argv, options)) {
+    std::cerr << "  Usage: glife_bench [setting.ini] [--max-size N] [--load-size N] [--warmup N] [--repetitions N]"
+              << " [--min-time ms] [--filter name]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  Config conf;
+  conf.load(options.settings);
+  std::ostream silent(nullptr);  //!<- Discards the messages of the engine selection.
+
+  const std::vector<size_t> sizes = { 64, 256, 1024, 4096, 8192 };
+  const std::vector<double> densities = { 0.1, 0.3, 0.5 };
+  constexpr size_t max_image_size = 1024;  //!<- Text and images of larger boards are never produced.
+
+  std::cout << "\n>>> Engine [" << conf.get_engine() << "], " << conf.get_threads() << " thread(s), "
+            << options.repetitions << " samples of at least " << options.min_sample_ms << " ms per case.\n\n";
+  std::cout << std::left << std::setw(28) << "case" << std::right << std::setw(10) << "iters" << std::setw(14)
+            << "median ms" << std::setw(14) << "p99 ms" << std::setw(14) << "per second" << std::setw(14)
+            << "Mcells/s" << std::setw(14) << "bytes" << std::endl;
+
+  const auto selected = [&](const std::string& name) {
+    return options.filter.empty() || name.find(options.filter) != std::string::npos;
+  };
+
+  for (const size_t size : sizes) {
+    if (size > options.max_size) { break; }
+
+    /// Generations per second; the board keeps evolving, so the density is the starting one.
+    for (const double density : densities) {
+      const std::string name = "update/" + std::to_string(size) + "/" + std::to_string(static_cast<int>(density * 100)) + "%";
+      if (!selected(name)) { continue; }
+
+      LifeCfg cfg(size, size);
+      cfg.set_log(silent);
+      randomize(cfg, density);
+      cfg.set_threads(conf.get_threads());
+      cfg.set_engine(conf);
+      run_case({ name, size * size, [&cfg] { cfg.update(); } }, options);
+    }
+
+    if (size > max_image_size) { continue; }
+
+    /// Two boards in turn, so every call draws a different generation.
+    LifeCfg boards[2] = { LifeCfg(size, size), LifeCfg(size, size) };
+    randomize(boards[0], 0.3);
+    randomize(boards[1], 0.5);
+    size_t turn = 0;
+
+    const std::string text_name = "to_string/" + std::to_string(size);
+    if (selected(text_name)) {
+      run_case({ text_name, size * size, [&] { (void)boards[turn++ & 1].to_string(); } }, options);
+    }
+
+    Canvas img(size, size, static_cast<int>(conf.get_block_size()));
+    const std::string img_name = "set_img/" + std::to_string(size);
+    if (selected(img_name)) {
+      run_case({ img_name, size * size, [&] { boards[turn++ & 1].set_img(img, conf); } }, options);
+    }
+
+    const std::string png_name = "encode_png/" + std::to_string(size);
+    if (selected(png_name)) {
+      const std::string filename = (std::filesystem::temp_directory_path() / "glife_bench.png").string();
+      boards[0].set_img(img, conf);
+      run_case({ png_name, size * size, [&] {
+                  LifeCfg::encode_png(filename, img.pixels(), static_cast<unsigned>(img.width()),
+                                      static_cast<unsigned>(img.height()));
+                } },
+               options);
+      std::filesystem::remove(filename);
+    }
+
+    /// The encoder of the image writer, on snapshots of the two boards in turn.
+    const std::string encoder_name = "png_encoder/" + std::to_string(size);
+    if (selected(encoder_name)) {
+      PngEncoder encoder(conf.get_alive_color(), conf.get_bkg_color(), conf.get_block_size(),
+                         conf.get_color_mode() == "palette",
+                         { conf.get_deflate_window(), conf.get_deflate_nicematch(), conf.get_deflate_lazy() });
+      Frame frames[2];
+      for (size_t i = 0; i < 2; ++i) {
+        frames[i].rows = size;
+        frames[i].cols = size;
+        boards[i].pack(frames[i].bits);
+      }
+      std::vector<unsigned char> png;
+      size_t bytes = 0;
+      run_case({ encoder_name, size * size,
+                 [&] {
+                   Frame& frame = frames[turn & 1];
+                   frame.sequence = turn++;
+                   encoder.encode(frame, png);
+                   bytes = png.size();
+                 },
+                 &bytes },
+               options);
+    }
+  }
+
+  /// Load time of a large pattern, with the memory-mapped loader and with the original one.
+  const std::string load_name = std::to_string(options.load_size);
+  if (options.load_size > 0 && (selected("load/mmap/" + load_name) || selected("load/lines/" + load_name))) {
+    const std::string filename = (std::filesystem::temp_directory_path() / "glife_bench.dat").string();
+    if (!write_pattern(filename, options.load_size)) {
+      std::cerr << "Failed to write the pattern [" << filename << "]!" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    LifeCfg cfg;
+    cfg.set_log(silent);
+    const size_t cells = options.load_size * options.load_size;
+    if (selected("load/mmap/" + load_name)) {
+      run_case({ "load/mmap/" + load_name, cells, [&] { cfg.load_from_file(filename, conf); } }, options);
+    }
+    if (selected("load/lines/" + load_name)) {
+      run_case({ "load/lines/" + load_name, cells, [&] { load_lines(cfg, filename); } }, options);
+    }
+    std::filesystem::remove(filename);
+  }
+
+  return EXIT_SUCCESS;
+}
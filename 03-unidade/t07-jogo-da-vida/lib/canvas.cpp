@@ -50,12 +50,10 @@ namespace life {
   */
   void Canvas::clear(const Color& color) {
 
-    /// Reset all pixel of image with the informed color.
+    /// Reset all pixel of image with the informed color, one whole pixel at a time.
+    const rgba_t value = rgba(color);
     for (size_t i = 0; i < m_pixels.size(); i += image_depth) {
-      m_pixels[i] = color.channels[Color::R];
-      m_pixels[i + 1] = color.channels[Color::G];
-      m_pixels[i + 2] = color.channels[Color::B];
-      m_pixels[i + 3] = 255;
+      std::memcpy(&m_pixels[i], &value, sizeof(rgba_t));
     }
   }
 
@@ -97,19 +95,74 @@ namespace life {
       throw std::invalid_argument("Pixel coordinate is outside the canvas.");
     }
 
-    size_t start_x = x * m_block_size;  //!<- X coordinate converted to the new size.
-    size_t start_y = y * m_block_size;  //!<- Y coordinate converted to the new size.
-
-    for (short i = 0; i < m_block_size; ++i) {
-      for (short j = 0; j < m_block_size; ++j) {
-        size_t index = (((start_y + i) * m_r_width) + (start_x + j)) * image_depth;   //!<- Initial index of each pixel.
-        
-        m_pixels[index] = color.channels[Color::R];
-        m_pixels[index + 1] = color.channels[Color::G];
-        m_pixels[index + 2] = color.channels[Color::B];
-        m_pixels[index + 3] = 255;
+    const rgba_t value = rgba(color);
+    const size_t line = m_r_width * image_depth;  //!<- Size of a row of real pixels.
+    component_t* block = m_pixels.data() + (y * m_block_size * m_r_width + x * m_block_size) * image_depth;
+
+    /// Fill the first row of the block and copy it to the others.
+    for (int j = 0; j < m_block_size; ++j) {
+      std::memcpy(block + j * image_depth, &value, sizeof(rgba_t));
+    }
+    for (int i = 1; i < m_block_size; ++i) {
+      std::memcpy(block + i * line, block, m_block_size * image_depth);
+    }
+  }
+
+  /*!
+  * Draw a whole row of the virtual image.
+  *
+  * The first real row of the blocks is drawn, one whole pixel at a time,
+  * and then copied to the other rows of the blocks. Pixels that already
+  * have the requested color are skipped, so redrawing a row that barely
+  * changed since the previous image is cheap.
+  *
+  * @param y The (virtual) Y coordinate of the row.
+  * @param colors The colors of the `width` pixels of the row, packed by `rgba()`.
+  * @return true if any pixel changed, false otherwise.
+  */
+  bool Canvas::row(coord_t y, const rgba_t* colors) {
+
+    /// Check if coords is valids.
+    if (y >= m_height) {
+      throw std::invalid_argument("Row coordinate is outside the canvas.");
+    }
+
+    const size_t line = m_r_width * image_depth;  //!<- Size of a row of real pixels.
+    component_t* first = m_pixels.data() + y * m_block_size * line;
+    bool changed = false;
+
+    for (coord_t x = 0; x < m_width; ++x) {
+      component_t* block = first + x * m_block_size * image_depth;
+
+      /// The first pixel of a block tells the color of the whole block.
+      rgba_t current;
+      std::memcpy(&current, block, sizeof(rgba_t));
+      if (current == colors[x]) { continue; }
+
+      for (int j = 0; j < m_block_size; ++j) {
+        std::memcpy(block + j * image_depth, &colors[x], sizeof(rgba_t));
+      }
+      changed = true;
+    }
+
+    if (changed) {
+      for (int i = 1; i < m_block_size; ++i) {
+        std::memcpy(first + i * line, first, line);
       }
     }
+    return changed;
+  }
+
+  /*!
+  * @param color The color.
+  * @return The color as a whole pixel, with an opaque alpha channel.
+  */
+  Canvas::rgba_t Canvas::rgba(const Color& color) {
+    const component_t channels[image_depth] = { color.channels[Color::R], color.channels[Color::G],
+                                                color.channels[Color::B], 255 };
+    rgba_t value;
+    std::memcpy(&value, channels, sizeof(rgba_t));
+    return value;
   }
 }  // namespace life
 
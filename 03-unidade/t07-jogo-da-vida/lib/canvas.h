@@ -36,6 +36,7 @@ class Canvas {
   //== Alias
   typedef uint8_t component_t;     //!< Type of a color channel.
   typedef unsigned long coord_t; //!< The pixel coordinate type.
+  typedef uint32_t rgba_t;         //!< A whole pixel, with its 4 channels in memory order.
   //== Constants
   static constexpr uint8_t image_depth = 4;  //!< Default value is RGBA (4 channels).
 
@@ -62,6 +63,10 @@ class Canvas {
   void pixel(coord_t, coord_t, const Color&);
   /// Get the pixel color from the canvas.
   Color pixel(coord_t, coord_t) const;
+  /// Set the colors of a whole row of pixels, skipping the ones that did not change.
+  bool row(coord_t, const rgba_t*);
+  /// Pack a color as a whole (opaque) pixel.
+  static rgba_t rgba(const Color&);
 
   //=== Attribute accessors members.
   /// Get the canvas width.
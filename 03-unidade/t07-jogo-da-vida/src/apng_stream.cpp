@@ -0,0 +1,172 @@
+/*!
+ * ApngStream class implementation.
+ * @file apng_stream.cpp
+ */
+
+#include "apng_stream.h"
+
+#include <cstring>
+
+#include "lodepng.h"
+
+namespace life {
+
+namespace {
+/// Appends a 32-bit big-endian integer to a buffer.
+void put_u32(std::vector<unsigned char>& out, uint32_t value) {
+  out.push_back(static_cast<unsigned char>(value >> 24));
+  out.push_back(static_cast<unsigned char>(value >> 16));
+  out.push_back(static_cast<unsigned char>(value >> 8));
+  out.push_back(static_cast<unsigned char>(value));
+}
+
+/// Appends a 16-bit big-endian integer to a buffer.
+void put_u16(std::vector<unsigned char>& out, uint16_t value) {
+  out.push_back(static_cast<unsigned char>(value >> 8));
+  out.push_back(static_cast<unsigned char>(value));
+}
+
+/// Reads a 32-bit big-endian integer.
+uint32_t get_u32(const unsigned char* in) {
+  return (uint32_t{ in[0] } << 24) | (uint32_t{ in[1] } << 16) | (uint32_t{ in[2] } << 8) | in[3];
+}
+
+/// Signature of every PNG file.
+const unsigned char png_signature[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+}  // namespace
+
+/// Destructor, closes the stream.
+ApngStream::~ApngStream() { close(); }
+
+/*!
+ * Sets the file that receives the animation and the frame rate.
+ * The file itself is created with the first frame.
+ * @param filename Name of the animation file.
+ * @param fps Frames per second of the animation.
+ */
+void ApngStream::open(const std::string& filename, unsigned fps) {
+  close();
+  m_filename = filename;
+  m_fps = fps == 0 ? 1 : fps;
+  m_frames = 0;
+  m_sequence = 0;
+}
+
+/*!
+ * Writes a chunk with the given type and data.
+ * @param type The four letter chunk type.
+ * @param data The chunk data.
+ */
+void ApngStream::write_chunk(const char* type, const std::vector<unsigned char>& data) {
+  std::vector<unsigned char> chunk;
+  chunk.reserve(data.size() + 12);
+  put_u32(chunk, static_cast<uint32_t>(data.size()));
+  chunk.insert(chunk.end(), type, type + 4);
+  chunk.insert(chunk.end(), data.begin(), data.end());
+  put_u32(chunk, lodepng_crc32(chunk.data() + 4, data.size() + 4));
+
+  m_file.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+}
+
+/*!
+ * Appends a frame, given as a complete PNG file in memory.
+ *
+ * The first frame also writes the PNG signature, its header chunks (IHDR
+ * and any chunk before the image data, such as a palette) and the acTL
+ * chunk, whose frame count is fixed by close().
+ * @param png The frame, encoded as a PNG file.
+ * @return true if the frame was written, false otherwise.
+ */
+bool ApngStream::add_frame(const std::vector<unsigned char>& png) {
+  if (png.size() < sizeof(png_signature) || std::memcmp(png.data(), png_signature, sizeof(png_signature)) != 0) {
+    return false;
+  }
+
+  const unsigned char* end = png.data() + png.size();
+  std::vector<unsigned char> header;   //!< Chunks before the image data, first frame only.
+  std::vector<unsigned char> pixels;   //!< Concatenated image data.
+  uint32_t width = 0;
+  uint32_t height = 0;
+
+  for (const unsigned char* chunk = png.data() + sizeof(png_signature); chunk + 12 <= end;
+       chunk = lodepng_chunk_next_const(chunk)) {
+    const unsigned length = lodepng_chunk_length(chunk);
+    const unsigned char* data = lodepng_chunk_data_const(chunk);
+
+    if (lodepng_chunk_type_equals(chunk, "IEND")) { break; }
+    if (lodepng_chunk_type_equals(chunk, "IDAT")) {
+      pixels.insert(pixels.end(), data, data + length);
+      continue;
+    }
+    if (lodepng_chunk_type_equals(chunk, "IHDR")) {
+      width = get_u32(data);
+      height = get_u32(data + 4);
+    }
+    if (pixels.empty()) { header.insert(header.end(), chunk, chunk + length + 12); }
+  }
+  if (width == 0 || height == 0 || pixels.empty()) { return false; }
+
+  /// The first frame creates the file.
+  if (m_frames == 0) {
+    m_file.open(m_filename, std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open()) { return false; }
+
+    m_file.write(reinterpret_cast<const char*>(png_signature), sizeof(png_signature));
+    /// IHDR must be the first chunk: write it, then acTL, then the rest of the header.
+    const unsigned ihdr_size = lodepng_chunk_length(header.data()) + 12;
+    m_file.write(reinterpret_cast<const char*>(header.data()), ihdr_size);
+
+    std::vector<unsigned char> actl;
+    put_u32(actl, 0);  // Number of frames, written by close().
+    put_u32(actl, 0);  // Number of plays, 0 loops forever.
+    m_actl_position = m_file.tellp();
+    write_chunk("acTL", actl);
+
+    m_file.write(reinterpret_cast<const char*>(header.data()) + ihdr_size,
+                 static_cast<std::streamsize>(header.size() - ihdr_size));
+  }
+
+  std::vector<unsigned char> fctl;
+  put_u32(fctl, m_sequence++);
+  put_u32(fctl, width);
+  put_u32(fctl, height);
+  put_u32(fctl, 0);  // X offset.
+  put_u32(fctl, 0);  // Y offset.
+  put_u16(fctl, 1);  // Delay numerator...
+  put_u16(fctl, static_cast<uint16_t>(m_fps));  // ...and denominator, in seconds.
+  fctl.push_back(0);  // Dispose: none.
+  fctl.push_back(0);  // Blend: source.
+  write_chunk("fcTL", fctl);
+
+  if (m_frames == 0) {
+    write_chunk("IDAT", pixels);
+  } else {
+    std::vector<unsigned char> fdat;
+    fdat.reserve(pixels.size() + 4);
+    put_u32(fdat, m_sequence++);
+    fdat.insert(fdat.end(), pixels.begin(), pixels.end());
+    write_chunk("fdAT", fdat);
+  }
+
+  ++m_frames;
+  return m_file.good();
+}
+
+/*!
+ * Writes the IEND chunk and the frame count, then closes the file.
+ */
+void ApngStream::close() {
+  if (!m_file.is_open()) { return; }
+
+  write_chunk("IEND", {});
+
+  std::vector<unsigned char> actl;
+  put_u32(actl, m_frames);
+  put_u32(actl, 0);
+  m_file.seekp(m_actl_position);
+  write_chunk("acTL", actl);
+
+  m_file.close();
+}
+
+}  // namespace life
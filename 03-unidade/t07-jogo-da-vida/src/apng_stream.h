@@ -0,0 +1,55 @@
+#ifndef APNG_STREAM_H
+#define APNG_STREAM_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace life {
+
+/*!
+ * Writes an animated PNG (APNG) file one frame at a time.
+ *
+ * Each frame is given as a complete PNG encoded by `lodepng`; its image data
+ * is moved into the animation as `IDAT` (first frame) or `fdAT` chunks, each
+ * preceded by a `fcTL` frame control chunk. Every frame must be encoded with
+ * the same size and color settings, since the header of the first one is
+ * used for the whole animation. The number of frames, unknown while
+ * streaming, is written into the `acTL` chunk when the stream is closed.
+ */
+class ApngStream {
+public:
+  //=== Special members
+  /// Constructor
+  ApngStream() = default;
+  /// Destructor, closes the stream.
+  ~ApngStream();
+
+  //=== Members
+  /// Sets the file that receives the animation and the frame rate.
+  void open(const std::string& filename, unsigned fps);
+  /// Appends a frame, given as a complete PNG file in memory.
+  bool add_frame(const std::vector<unsigned char>& png);
+  /// Writes the frame count and closes the file.
+  void close();
+
+  //=== Attribute accessors members.
+  /// Number of frames written.
+  [[nodiscard]] uint32_t frames() const { return m_frames; }
+
+private:
+  /// Writes a chunk with the given type and data.
+  void write_chunk(const char* type, const std::vector<unsigned char>& data);
+
+  std::ofstream m_file;               //!< The animation file.
+  std::string m_filename;             //!< Name of the animation file.
+  unsigned m_fps{ 1 };                //!< Frames per second.
+  uint32_t m_frames{ 0 };             //!< Number of frames written.
+  uint32_t m_sequence{ 0 };           //!< Sequence number of the next fcTL/fdAT chunk.
+  std::streampos m_actl_position;     //!< Position of the acTL chunk in the file.
+};
+
+}  // namespace life
+
+#endif  // APNG_STREAM_H
@@ -0,0 +1,190 @@
+/*!
+ * Batch class implementation.
+ * @file batch.cpp
+ */
+
+#include "batch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+#include "life.h"
+#include "stability.h"
+#include "thread_pool.h"
+
+namespace life {
+
+namespace {
+/// Writes a CSV field, quoted if it holds a separator, a quote or a line break.
+void write_field(std::ostream& out, const std::string& field) {
+  if (field.find_first_of(",\"\n") == std::string::npos) {
+    out << field;
+    return;
+  }
+  out << '"';
+  for (const char c : field) { out << (c == '"' ? "\"\"" : std::string(1, c)); }
+  out << '"';
+}
+}  // namespace
+
+/*!
+ * Lists the pattern files of a directory (.dat, .rle and .cells), in name
+ * order, or the files named in a list file, one per line; blank lines and
+ * lines starting with '#' are skipped.
+ * @param path A directory or a list file.
+ * @return The pattern files, empty if the path cannot be read.
+ */
+std::vector<std::string> Batch::list_patterns(const std::string& path) {
+  std::vector<std::string> filenames;
+  std::error_code error;
+
+  if (std::filesystem::is_directory(path, error)) {
+    for (const auto& entry : std::filesystem::directory_iterator(path, error)) {
+      const std::string extension = entry.path().extension().string();
+      if (entry.is_regular_file(error) && (extension == ".dat" || extension == ".rle" || extension == ".cells")) {
+        filenames.push_back(entry.path().string());
+      }
+    }
+    std::sort(filenames.begin(), filenames.end());
+    return filenames;
+  }
+
+  std::ifstream list(path);
+  std::string line;
+  while (std::getline(list, line)) {
+    if (!line.empty() && line.back() == '\r') { line.pop_back(); }
+    if (!line.empty() && line.front() != '#') { filenames.push_back(line); }
+  }
+  return filenames;
+}
+
+/*!
+ * Simulates each pattern file on the workers of a pool, reporting each
+ * simulation as it finishes.
+ * @param filenames The pattern files.
+ * @return The summary of each simulation, in the order of the files.
+ */
+std::vector<BatchResult> Batch::run(const std::vector<std::string>& filenames) {
+  std::vector<BatchResult> results(filenames.size());
+  ThreadPool pool(m_config.get_batch_workers());
+  m_finished = 0;
+
+  std::cout << ">>> Simulating " << filenames.size() << " patterns on " << pool.size() << " workers..." << std::endl;
+  pool.run(filenames.size(), [&](size_t i) {
+    results[i] = simulate(filenames[i]);
+
+    const BatchResult& result = results[i];
+    std::lock_guard<std::mutex> lock(m_output);
+    std::cout << "[" << ++m_finished << "/" << filenames.size() << "] " << result.filename << ": " << result.outcome;
+    if (result.outcome == "error") {
+      std::cout << " (" << result.error << ")";
+    } else {
+      std::cout << " at generation " << result.generations;
+      if (result.outcome == "stable") { std::cout << " with period " << result.period; }
+    }
+    std::cout << " in " << std::fixed << std::setprecision(1) << result.wall_ms << " ms." << std::defaultfloat
+              << std::endl;
+  });
+  return results;
+}
+
+/*!
+ * Simulates a pattern file with the settings of the config until it dies
+ * out, repeats a board or reaches < max_gen >, as the interactive
+ * simulation does, but without any output. Each simulation runs on the
+ * thread of its worker.
+ * @param filename The pattern file.
+ * @return The summary of the simulation.
+ */
+BatchResult Batch::simulate(const std::string& filename) {
+  const auto start = std::chrono::steady_clock::now();
+  BatchResult result;
+  result.filename = filename;
+
+  try {
+    std::ostream silent(nullptr);  //!<- Discards the loading messages.
+    LifeCfg cfg;
+    cfg.set_log(silent);
+
+    if (!cfg.load_from_file(filename, m_config)) {
+      result.outcome = "error";
+      result.error = "cannot open the file";
+    } else {
+      cfg.set_threads(1);
+      cfg.set_engine(m_config);
+      result.rows = cfg.m_rows;
+      result.cols = cfg.m_cols;
+      result.rule = cfg.rule().to_string();
+
+      StabilityDetector detector;
+      const size_t max_gen = m_config.get_max_gen() == 0 ? 99999 : m_config.get_max_gen();
+      size_t generation = 1;
+
+      result.outcome = "max_gen";
+      for (; generation <= max_gen; ++generation) {
+        result.population.push_back(cfg.population());
+        if (result.population.back() == 0) {
+          result.outcome = "extinct";
+          break;
+        }
+        if (detector.observe(cfg, generation)) {
+          result.outcome = "stable";
+          result.first_generation = detector.first_generation();
+          result.period = generation - result.first_generation;
+          break;
+        }
+        cfg.update();
+      }
+      result.generations = std::min(generation, max_gen);
+    }
+  } catch (const std::exception& e) {
+    result.outcome = "error";
+    result.error = e.what();
+  }
+
+  result.wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  return result;
+}
+
+/*!
+ * Writes the summaries as a CSV table, one simulation per line. The
+ * population curve is a list of populations separated by ';', sampled at
+ * evenly spaced generations.
+ * @param results The summaries.
+ * @param filename Name of the CSV file.
+ * @param curve_points Maximum number of populations in each curve, zero for every generation.
+ * @return true if the file was written, false otherwise.
+ */
+bool Batch::write_csv(const std::vector<BatchResult>& results, const std::string& filename, size_t curve_points) {
+  std::ofstream csv(filename);
+  if (!csv.is_open()) { return false; }
+
+  csv << "file,rows,cols,rule,outcome,generations,first_generation,period,"
+      << "initial_population,final_population,peak_population,wall_ms,population_curve,error\n";
+  for (const auto& result : results) {
+    const auto& population = result.population;
+    const size_t points = curve_points == 0 ? population.size() : std::min(curve_points, population.size());
+
+    write_field(csv, result.filename);
+    csv << ',' << result.rows << ',' << result.cols << ',' << result.rule << ',' << result.outcome << ','
+        << result.generations << ',' << result.first_generation << ',' << result.period << ','
+        << (population.empty() ? 0 : population.front()) << ',' << (population.empty() ? 0 : population.back()) << ','
+        << (population.empty() ? 0 : *std::max_element(population.begin(), population.end())) << ','
+        << std::fixed << std::setprecision(3) << result.wall_ms << std::defaultfloat << ',';
+    for (size_t i = 0; i < points; ++i) {
+      const size_t generation = points == 1 ? 0 : i * (population.size() - 1) / (points - 1);
+      csv << (i > 0 ? ";" : "") << population[generation];
+    }
+    csv << ',';
+    write_field(csv, result.error);
+    csv << '\n';
+  }
+  return static_cast<bool>(csv);
+}
+
+}  // namespace life
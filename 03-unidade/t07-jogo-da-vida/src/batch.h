@@ -0,0 +1,62 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "config.h"
+
+namespace life {
+
+/// Summary of one simulation of a batch.
+struct BatchResult {
+  std::string filename;              //!< Pattern file of the simulation.
+  std::string outcome;               //!< "extinct", "stable", "max_gen" or "error".
+  std::string error;                 //!< Why the simulation could not run, for the "error" outcome.
+  size_t rows{ 0 };                  //!< Number of rows of the board.
+  size_t cols{ 0 };                  //!< Number of columns of the board.
+  std::string rule;                  //!< Rule of the simulation.
+  size_t generations{ 0 };           //!< Generation in which the simulation stopped.
+  size_t first_generation{ 0 };      //!< Generation in which the repeated board first appeared.
+  size_t period{ 0 };                //!< Generations between the repetitions of a stable board.
+  std::vector<size_t> population;    //!< Alive cells in each generation.
+  double wall_ms{ 0 };               //!< Wall time of the simulation, loading included.
+};
+
+/*!
+ * Runs the simulation of many patterns, each one on a worker of a pool,
+ * with the settings of a single config, and writes a summary of each
+ * simulation as a CSV table.
+ *
+ * The simulations are independent, so they run in parallel with one
+ * thread each; a worker takes the next pattern as soon as it finishes
+ * one, so long and short simulations are balanced among the workers.
+ */
+class Batch {
+public:
+  //=== Special members
+  /// Constructor
+  explicit Batch(Config& ini_config) : m_config(ini_config) {}
+
+  //=== Members
+  /// Lists the pattern files of a directory, or the files named in a list file.
+  static std::vector<std::string> list_patterns(const std::string& path);
+  /// Simulates each pattern file, returning their summaries in the same order.
+  std::vector<BatchResult> run(const std::vector<std::string>& filenames);
+  /// Writes the summaries as a CSV table, the population curve sampled at most `curve_points` times.
+  static bool write_csv(const std::vector<BatchResult>& results, const std::string& filename, size_t curve_points);
+
+private:
+  /// Simulates a pattern file.
+  BatchResult simulate(const std::string& filename);
+
+  Config& m_config;       //!< Settings shared by every simulation.
+  std::mutex m_output;    //!< Guards the progress messages of the workers.
+  size_t m_finished{ 0 }; //!< Number of simulations already finished.
+};
+
+}  // namespace life
+
+#endif  // BATCH_H
@@ -0,0 +1,409 @@
+/*!
+ * BitBoard class implementation.
+ * @file bit_board.cpp
+ */
+
+#include "bit_board.h"
+
+#include <algorithm>
+#include <bitset>
+
+#include "life.h"
+#include "thread_pool.h"
+
+namespace life {
+
+namespace {
+/// Adds three bit masks, producing the sum and carry masks.
+inline void full_add(BitBoard::word_t a,
+                     BitBoard::word_t b,
+                     BitBoard::word_t c,
+                     BitBoard::word_t& sum,
+                     BitBoard::word_t& carry) {
+  const BitBoard::word_t partial = a ^ b;
+  sum = partial ^ c;
+  carry = (a & b) | (partial & c);
+}
+
+/// Adds two bit masks, producing the sum and carry masks.
+inline void half_add(BitBoard::word_t a,
+                     BitBoard::word_t b,
+                     BitBoard::word_t& sum,
+                     BitBoard::word_t& carry) {
+  sum = a ^ b;
+  carry = a & b;
+}
+
+/*!
+ * Applies a rule to the bit-sliced neighbor counts of a word, where each
+ * count is ones + 2 * twos + 4 * fours + 8 * eights: the cells whose count
+ * is in the birth (or, if alive, the survival) mask are alive.
+ */
+template <typename KernelRule>
+inline BitBoard::word_t apply_rule(const KernelRule& rule,
+                                   BitBoard::word_t mid,
+                                   BitBoard::word_t ones,
+                                   BitBoard::word_t twos,
+                                   BitBoard::word_t fours,
+                                   BitBoard::word_t eights) {
+  BitBoard::word_t next = 0;
+  for (unsigned n = 0; n <= 8; ++n) {
+    const bool born = (rule.birth >> n) & 1U;
+    const bool kept = (rule.survival >> n) & 1U;
+    if (!born && !kept) { continue; }
+
+    const BitBoard::word_t count = (n & 1 ? ones : ~ones) & (n & 2 ? twos : ~twos) & (n & 4 ? fours : ~fours)
+                                   & (n & 8 ? eights : ~eights);
+    next |= count & (born && kept ? ~BitBoard::word_t{ 0 } : born ? ~mid : mid);
+  }
+  return next;
+}
+
+/// B3/S23: alive with count 3, or alive with count 2; a count of 8 has no twos.
+template <>
+inline BitBoard::word_t apply_rule(const ConwayRule&,
+                                   BitBoard::word_t mid,
+                                   BitBoard::word_t ones,
+                                   BitBoard::word_t twos,
+                                   BitBoard::word_t fours,
+                                   BitBoard::word_t) {
+  return twos & ~fours & (ones | mid);
+}
+}  // namespace
+
+/// Constructor
+BitBoard::BitBoard(size_t rows, size_t cols) { resize(rows, cols); }
+
+/*!
+ * Reallocates the buffers for a board of the given size, with all cells dead.
+ * @param rows Number of rows, without the ghost border.
+ * @param cols Number of columns, without the ghost border.
+ */
+void BitBoard::resize(size_t rows, size_t cols) {
+  m_rows = rows;
+  m_cols = cols;
+  m_words = (cols + 2 + word_bits - 1) / word_bits;
+
+  m_cells.assign((rows + 2) * m_words, 0);
+  m_next.assign((rows + 2) * m_words, 0);
+  m_mask.assign(m_words, 0);
+
+  /// Only the columns in [1, cols] may ever hold a live cell.
+  for (size_t c = 1; c <= cols; ++c) {
+    m_mask[c / word_bits] |= word_t{ 1 } << (c % word_bits);
+  }
+}
+
+/*!
+ * Tells whether the cell at (r, c) is alive.
+ * @param r Row of the cell, in expanded board coordinates.
+ * @param c Column of the cell, in expanded board coordinates.
+ * @return true if the cell is alive, false otherwise.
+ */
+bool BitBoard::get(size_t r, size_t c) const {
+  return (m_cells[r * m_words + c / word_bits] >> (c % word_bits)) & 1U;
+}
+
+/*!
+ * Sets the state of the cell at (r, c).
+ * @param r Row of the cell, in expanded board coordinates.
+ * @param c Column of the cell, in expanded board coordinates.
+ * @param alive New state of the cell.
+ */
+void BitBoard::set(size_t r, size_t c, bool alive) {
+  word_t& word = m_cells[r * m_words + c / word_bits];
+  const word_t bit = word_t{ 1 } << (c % word_bits);
+  if (alive) {
+    word |= bit;
+  } else {
+    word &= ~bit;
+  }
+}
+
+/*!
+ * Selects the topology used by the next load.
+ * @param topology What lies beyond the edges of the board.
+ * @return true, every topology is supported.
+ */
+bool BitBoard::set_topology(e_topology topology) {
+  m_topology = topology;
+  return true;
+}
+
+/*!
+ * Packs the alive cells of a board.
+ * On a plane the buffer is as wide as its words, so its columns fill them.
+ * @param cfg The board to be copied.
+ */
+void BitBoard::load(const LifeCfg& cfg) {
+  m_window_rows = cfg.m_rows;
+  m_window_cols = cfg.m_cols;
+  m_origin_row = 0;
+  m_origin_col = 0;
+
+  if (m_topology == e_topology::PLANE) {
+    resize(cfg.m_rows, (cfg.m_cols + 2 + word_bits - 1) / word_bits * word_bits - 2);
+  } else {
+    resize(cfg.m_rows, cfg.m_cols);
+  }
+  for (size_t r = 1; r <= m_window_rows; ++r) {
+    for (size_t c = 1; c <= m_window_cols; ++c) {
+      if (cfg.get_cell(r, c).is_alive) { set(r, c, true); }
+    }
+  }
+}
+
+/*!
+ * Unpacks the current generation, inside the window of the board, into the board cells.
+ * @param cfg The board that receives the current generation.
+ */
+void BitBoard::store(LifeCfg& cfg) {
+  for (size_t r = 1; r <= m_window_rows; ++r) {
+    for (size_t c = 1; c <= m_window_cols; ++c) {
+      cfg.set_alive(r, c, get(r + m_origin_row, c + m_origin_col));
+    }
+  }
+}
+
+/*!
+ * Copies the opposite edges into the ghost border, so the neighbors read
+ * across an edge are the ones of a torus.
+ */
+void BitBoard::wrap_border() {
+  for (size_t r = 1; r <= m_rows; ++r) {
+    set(r, 0, get(r, m_cols));
+    set(r, m_cols + 1, get(r, 1));
+  }
+  /// Whole rows, after the columns, so the corners are wrapped too.
+  std::copy(row(m_cells, m_rows), row(m_cells, m_rows) + m_words, row(m_cells, 0));
+  std::copy(row(m_cells, 1), row(m_cells, 1) + m_words, row(m_cells, m_rows + 1));
+}
+
+/*!
+ * Grows the buffer on the sides where a live cell reached its edge, so the
+ * cells born beyond it in the next generation fit in the buffer.
+ * Columns grow by whole words, so the rows are copied without shifting bits.
+ */
+void BitBoard::grow() {
+  const word_t* top = row(m_cells, 1);
+  const word_t* bottom = row(m_cells, m_rows);
+  bool grow_top = false;
+  bool grow_bottom = false;
+  bool grow_left = false;
+  bool grow_right = false;
+
+  for (size_t k = 0; k < m_words; ++k) {
+    grow_top = grow_top || top[k] != 0;
+    grow_bottom = grow_bottom || bottom[k] != 0;
+  }
+  for (size_t r = 1; r <= m_rows; ++r) {
+    grow_left = grow_left || get(r, 1);
+    grow_right = grow_right || get(r, m_cols);
+  }
+  if (!grow_top && !grow_bottom && !grow_left && !grow_right) { return; }
+
+  const size_t chunk_rows = std::max<size_t>(word_bits, m_rows / 2);
+  const size_t chunk_words = std::max<size_t>(1, m_words / 2);
+  const size_t add_top = grow_top ? chunk_rows : 0;
+  const size_t add_left = grow_left ? chunk_words : 0;
+  const size_t rows = m_rows + add_top + (grow_bottom ? chunk_rows : 0);
+  const size_t words = m_words + add_left + (grow_right ? chunk_words : 0);
+
+  std::vector<word_t> cells((rows + 2) * words, 0);
+  for (size_t r = 0; r < m_rows + 2; ++r) {
+    std::copy(row(m_cells, r), row(m_cells, r) + m_words, cells.data() + (r + add_top) * words + add_left);
+  }
+
+  resize(rows, words * word_bits - 2);
+  m_cells.swap(cells);
+  m_origin_row += add_top;
+  m_origin_col += add_left * word_bits;
+}
+
+/*!
+ * Describes the live cells of a plane for the stability detector: the
+ * bounding box of the live cells, as its first row and column relative to
+ * the window (two's complement) and its height and width, followed by its
+ * cells bit-packed in row-major order. Two generations have the same key
+ * only if the whole plane is the same, wherever the buffer has grown.
+ * @param key Receives the key.
+ * @return true on a plane, false when the window is the whole board.
+ */
+bool BitBoard::plane_key(std::vector<word_t>& key) const {
+  if (m_topology != e_topology::PLANE) { return false; }
+
+  size_t top = m_rows + 1, bottom = 0, left = m_cols + 1, right = 0;
+  for (size_t r = 1; r <= m_rows; ++r) {
+    const word_t* words = m_cells.data() + r * m_words;
+    for (size_t k = 0; k < m_words; ++k) {
+      if (words[k] == 0) { continue; }
+      top = std::min(top, r);
+      bottom = r;
+      left = std::min(left, k * word_bits + static_cast<size_t>(__builtin_ctzll(words[k])));
+      right = std::max(right, k * word_bits + word_bits - 1 - static_cast<size_t>(__builtin_clzll(words[k])));
+    }
+  }
+
+  key.assign(4, 0);
+  if (bottom == 0) { return true; }
+
+  const size_t height = bottom - top + 1;
+  const size_t width = right - left + 1;
+  key[0] = static_cast<word_t>(static_cast<int64_t>(top) - static_cast<int64_t>(m_origin_row));
+  key[1] = static_cast<word_t>(static_cast<int64_t>(left) - static_cast<int64_t>(m_origin_col));
+  key[2] = height;
+  key[3] = width;
+  key.resize(4 + (height * width + word_bits - 1) / word_bits, 0);
+
+  /// Copy each row of the box, up to a word at a time, after the bits of the rows above it.
+  word_t* out = key.data() + 4;
+  size_t bit = 0;
+  for (size_t r = top; r <= bottom; ++r) {
+    const word_t* words = m_cells.data() + r * m_words;
+    for (size_t c = left; c <= right; c += word_bits) {
+      const size_t count = std::min(word_bits, right + 1 - c);
+      const size_t k = c / word_bits, shift = c % word_bits;
+      word_t value = words[k] >> shift;
+      if (shift != 0 && k + 1 < m_words) { value |= words[k + 1] << (word_bits - shift); }
+      if (count < word_bits) { value &= (word_t{ 1 } << count) - 1; }
+
+      out[bit / word_bits] |= value << (bit % word_bits);
+      if (bit % word_bits != 0 && bit % word_bits + count > word_bits) {
+        out[bit / word_bits + 1] |= value >> (word_bits - bit % word_bits);
+      }
+      bit += count;
+    }
+  }
+  return true;
+}
+
+/*!
+ * Replaces the board with the live cells of a plane written by save_plane()
+ * (see plane_key()). The buffer holds the window of the board and the box
+ * of the live cells, wherever the box lies.
+ * @param cfg The board whose window is shown.
+ * @param plane The live cells of the plane.
+ * @return true on a plane, false when the window is the whole board.
+ */
+bool BitBoard::load_plane(const LifeCfg& cfg, const std::vector<word_t>& plane) {
+  if (m_topology != e_topology::PLANE || plane.size() < 4) { return false; }
+
+  const int64_t top = static_cast<int64_t>(plane[0]);
+  const int64_t left = static_cast<int64_t>(plane[1]);
+  const size_t height = static_cast<size_t>(plane[2]);
+  const size_t width = static_cast<size_t>(plane[3]);
+  if (plane.size() < 4 + (height * width + word_bits - 1) / word_bits) { return false; }
+
+  /// The buffer spans the window, rows and columns [1, size], and the box.
+  m_window_rows = cfg.m_rows;
+  m_window_cols = cfg.m_cols;
+  const int64_t first_row = height == 0 ? 1 : std::min<int64_t>(1, top);
+  const int64_t first_col = width == 0 ? 1 : std::min<int64_t>(1, left);
+  const int64_t last_row = height == 0 ? static_cast<int64_t>(m_window_rows)
+                                       : std::max(static_cast<int64_t>(m_window_rows), top + static_cast<int64_t>(height) - 1);
+  const int64_t last_col = width == 0 ? static_cast<int64_t>(m_window_cols)
+                                      : std::max(static_cast<int64_t>(m_window_cols), left + static_cast<int64_t>(width) - 1);
+  m_origin_row = static_cast<size_t>(1 - first_row);
+  m_origin_col = static_cast<size_t>(1 - first_col);
+  const size_t cols = static_cast<size_t>(last_col - first_col + 1);
+  resize(static_cast<size_t>(last_row - first_row + 1), (cols + 2 + word_bits - 1) / word_bits * word_bits - 2);
+
+  const word_t* bits = plane.data() + 4;
+  for (size_t i = 0; i < height * width; ++i) {
+    if ((bits[i / word_bits] >> (i % word_bits)) & 1U) {
+      set(static_cast<size_t>(top + static_cast<int64_t>(i / width) + static_cast<int64_t>(m_origin_row)),
+          static_cast<size_t>(left + static_cast<int64_t>(i % width) + static_cast<int64_t>(m_origin_col)), true);
+    }
+  }
+  return true;
+}
+
+/*!
+ * Counts the alive cells, a whole word at a time, including the ones outside the window of a plane.
+ * @return The number of alive cells.
+ */
+size_t BitBoard::population() const {
+  size_t count = 0;
+  for (const word_t word : m_cells) { count += std::bitset<word_bits>(word).count(); }
+  return count;
+}
+
+/*!
+ * Computes the next generation with word-wide adders, splitting the rows
+ * in bands among the threads of the pool, if there is one.
+ * The ghost columns are masked out of each computed word; on a torus the
+ * ghost rows are killed again after stepping, so population() only counts
+ * the board.
+ */
+void BitBoard::step() {
+  if (m_topology == e_topology::TORUS) { wrap_border(); }
+  if (m_topology == e_topology::PLANE) { grow(); }
+
+  with_rule(m_rule, [this](const auto& rule) {
+    if (m_pool != nullptr) {
+      m_pool->for_each_band(1, m_rows + 1, [this, &rule](size_t first, size_t last) { step_rows(first, last, rule); });
+    } else {
+      step_rows(1, m_rows + 1, rule);
+    }
+  });
+
+  if (m_topology == e_topology::TORUS) {
+    std::fill(row(m_cells, 0), row(m_cells, 0) + m_words, 0);
+    std::fill(row(m_cells, m_rows + 1), row(m_cells, m_rows + 1) + m_words, 0);
+  }
+  m_cells.swap(m_next);
+}
+
+/*!
+ * Computes the next generation of the rows in [first, last) into m_next.
+ *
+ * For each word the eight neighbor masks are built by shifting the words
+ * of the rows above, at and below it one bit to each side (carrying the
+ * edge bit over from the adjacent word). Their sum is kept in four bit
+ * planes, on which the rule is applied.
+ * Rows only read the current generation, so bands of rows are independent.
+ * @param first First row to be computed.
+ * @param last One past the last row to be computed.
+ * @param rule Kernel rule: B3/S23 has its own expression, other rules test each count.
+ */
+template <typename KernelRule>
+void BitBoard::step_rows(size_t first, size_t last, const KernelRule& rule) {
+  for (size_t r = first; r < last; ++r) {
+    const word_t* up = row(m_cells, r - 1);
+    const word_t* mid = row(m_cells, r);
+    const word_t* down = row(m_cells, r + 1);
+    word_t* out = row(m_next, r);
+
+    for (size_t k = 0; k < m_words; ++k) {
+      const bool has_prev = k > 0;
+      const bool has_next = k + 1 < m_words;
+
+      /// Neighbors from the west (column - 1) and east (column + 1) of each bit.
+      const word_t up_w = (up[k] << 1) | (has_prev ? up[k - 1] >> (word_bits - 1) : 0);
+      const word_t up_e = (up[k] >> 1) | (has_next ? up[k + 1] << (word_bits - 1) : 0);
+      const word_t mid_w = (mid[k] << 1) | (has_prev ? mid[k - 1] >> (word_bits - 1) : 0);
+      const word_t mid_e = (mid[k] >> 1) | (has_next ? mid[k + 1] << (word_bits - 1) : 0);
+      const word_t down_w = (down[k] << 1) | (has_prev ? down[k - 1] >> (word_bits - 1) : 0);
+      const word_t down_e = (down[k] >> 1) | (has_next ? down[k + 1] << (word_bits - 1) : 0);
+
+      /// Adds the eight masks: first in groups, then the partial sums of each weight.
+      word_t sum_a, carry_a, sum_b, carry_b, sum_c, carry_c;
+      full_add(up_w, up[k], up_e, sum_a, carry_a);
+      full_add(mid_w, mid_e, down_w, sum_b, carry_b);
+      half_add(down[k], down_e, sum_c, carry_c);
+
+      word_t ones, carry_d;
+      full_add(sum_a, sum_b, sum_c, ones, carry_d);
+
+      word_t twos_partial, fours_a, twos, fours_b;
+      full_add(carry_a, carry_b, carry_c, twos_partial, fours_a);
+      half_add(twos_partial, carry_d, twos, fours_b);
+      const word_t fours = fours_a ^ fours_b;
+      const word_t eights = fours_a & fours_b;
+
+      out[k] = apply_rule(rule, mid[k], ones, twos, fours, eights) & m_mask[k];
+    }
+  }
+}
+
+}  // namespace life
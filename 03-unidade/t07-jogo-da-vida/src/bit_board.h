@@ -0,0 +1,99 @@
+#ifndef BIT_BOARD_H
+#define BIT_BOARD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "engine.h"
+
+namespace life {
+
+/*!
+ * Bit-packed life board, storing 64 cells per machine word.
+ *
+ * Cells use the same coordinates as the expanded board of `LifeCfg`: rows
+ * and columns `0` and `rows + 1`/`cols + 1` form a ghost border that is
+ * always dead. Bit `j` of word `k` of a row holds column `k * 64 + j`.
+ *
+ * The next generation is computed a whole word at a time: the eight
+ * neighbor masks of a word are added with bit-sliced full adders and
+ * the rule is applied on the resulting count bits.
+ *
+ * On a torus the ghost border holds the opposite edges while stepping. On
+ * a plane the board is a window on a larger buffer, which grows before a
+ * live cell reaches its edge; it grows by a whole number of words and by
+ * half its size, so a pattern that keeps growing is only copied a
+ * logarithmic number of times.
+ */
+class BitBoard : public Engine {
+public:
+  //=== Alias
+  typedef uint64_t word_t;  //!< Type of a packed group of cells.
+  //=== Constants
+  static constexpr size_t word_bits = 64;  //!< Number of cells stored in a word.
+
+  //=== Special members
+  /// Constructor
+  BitBoard(size_t rows = 0, size_t cols = 0);
+  /// Destructor
+  ~BitBoard() override = default;
+
+  //=== Engine interface.
+  /// Packs the alive cells of a board.
+  void load(const LifeCfg& cfg) override;
+  /// Computes the next generation with word-wide adders.
+  void step() override;
+  /// Unpacks the current generation into the board cells.
+  void store(LifeCfg& cfg) override;
+  /// Counts the alive cells, including the ones outside the window of a plane.
+  [[nodiscard]] size_t population() const override;
+  /// Selects the topology used by the next load; every topology is supported.
+  bool set_topology(e_topology topology) override;
+  /// Describes the live cells of a plane, with their place relative to the window.
+  bool plane_key(std::vector<word_t>& key) const override;
+  /// Plane keys are the live cells themselves.
+  [[nodiscard]] bool portable_plane_key() const override { return m_topology == e_topology::PLANE; }
+  /// Writes the live cells of a plane, as its key.
+  bool save_plane(std::vector<word_t>& plane) const override { return plane_key(plane); }
+  /// Replaces the board with the live cells of a plane, around the window of a board.
+  bool load_plane(const LifeCfg& cfg, const std::vector<word_t>& plane) override;
+
+  //=== Attribute accessors members.
+  /// Number of rows of the buffer, without the ghost border.
+  [[nodiscard]] size_t rows() const { return m_rows; }
+  /// Number of columns of the buffer, without the ghost border.
+  [[nodiscard]] size_t cols() const { return m_cols; }
+  /// Tells whether the cell at (r, c) is alive.
+  [[nodiscard]] bool get(size_t r, size_t c) const;
+  /// Sets the state of the cell at (r, c).
+  void set(size_t r, size_t c, bool alive);
+
+private:
+  /// Computes the next generation of the rows in [first, last), with a kernel rule.
+  template <typename KernelRule>
+  void step_rows(size_t first, size_t last, const KernelRule& rule);
+  /// Reallocates the buffers for a board of the given size, with all cells dead.
+  void resize(size_t rows, size_t cols);
+  /// Copies the opposite edges into the ghost border (torus).
+  void wrap_border();
+  /// Grows the buffer on the sides where a live cell reached its edge (plane).
+  void grow();
+  /// Returns a pointer to the first word of a row.
+  word_t* row(std::vector<word_t>& buffer, size_t r) { return buffer.data() + r * m_words; }
+
+  size_t m_rows{ 0 };            //!< Number of rows in the buffer.
+  size_t m_cols{ 0 };            //!< Number of columns in the buffer.
+  size_t m_window_rows{ 0 };     //!< Number of rows in the game board.
+  size_t m_window_cols{ 0 };     //!< Number of columns in the game board.
+  size_t m_origin_row{ 0 };      //!< Buffer row of the ghost row above the game board.
+  size_t m_origin_col{ 0 };      //!< Buffer column of the ghost column left of the game board.
+  size_t m_words{ 0 };           //!< Number of words in each row, ghost columns included.
+  std::vector<word_t> m_cells;   //!< Current generation, `(rows + 2) * words` words.
+  std::vector<word_t> m_next;    //!< Buffer where the next generation is computed.
+  std::vector<word_t> m_mask;    //!< Per word mask of the columns inside the board.
+};
+
+}  // namespace life
+
+#endif  // BIT_BOARD_H
@@ -0,0 +1,316 @@
+/*!
+ * ByteBoard class implementation.
+ * @file byte_board.cpp
+ */
+
+#include "byte_board.h"
+
+#include <numeric>
+#include <type_traits>
+
+#include "life.h"
+#include "thread_pool.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# define LIFE_X86_KERNELS 1
+# include <immintrin.h>
+#endif
+
+namespace life {
+
+namespace {
+/*!
+ * Masks and state table used by a kernel: the constants of a static rule,
+ * so the kernel folds them, or the table rule it receives at runtime.
+ * @param rule The table rule of the simulation.
+ * @return The static rule, or `rule` itself for a table rule.
+ */
+template <typename KernelRule>
+const auto& kernel_rule(const TableRule& rule) {
+  if constexpr (std::is_same_v<KernelRule, TableRule>) {
+    return rule;
+  } else {
+    static constexpr KernelRule fixed{};
+    return fixed;
+  }
+}
+
+/*!
+ * Scalar kernel, used for any processor and for the tail of the vector kernels.
+ * B3/S23 is tested directly; any other rule is looked up in its state table.
+ */
+template <typename KernelRule>
+void step_row_scalar(const ByteBoard::cell_t* up,
+                     const ByteBoard::cell_t* mid,
+                     const ByteBoard::cell_t* down,
+                     ByteBoard::cell_t* out,
+                     size_t count,
+                     const TableRule& table) {
+  const auto& rule = kernel_rule<KernelRule>(table);
+  for (size_t c = 0; c < count; ++c) {
+    const unsigned alive_neighbors = up[c - 1] + up[c] + up[c + 1] + mid[c - 1] + mid[c + 1]
+                                     + down[c - 1] + down[c] + down[c + 1];
+    if constexpr (std::is_same_v<KernelRule, ConwayRule>) {
+      out[c] = alive_neighbors == 3 || (alive_neighbors == 2 && mid[c]);
+    } else {
+      out[c] = rule.table.next[mid[c]][alive_neighbors];
+    }
+  }
+}
+
+#ifdef LIFE_X86_KERNELS
+/// Loads 16 cells, from any address.
+__attribute__((target("sse2"))) inline __m128i load_sse2(const ByteBoard::cell_t* cells) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(cells));
+}
+
+/// Loads 32 cells, from any address.
+__attribute__((target("avx2"))) inline __m256i load_avx2(const ByteBoard::cell_t* cells) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cells));
+}
+
+/*!
+ * SSE2 kernel, 16 cells per iteration.
+ * B3/S23 compares the sums with 2 and 3; any other rule compares them with
+ * each count of its masks, which a static rule folds to the counts it uses.
+ */
+template <typename KernelRule>
+__attribute__((target("sse2"))) void step_row_sse2(const ByteBoard::cell_t* up,
+                                                   const ByteBoard::cell_t* mid,
+                                                   const ByteBoard::cell_t* down,
+                                                   ByteBoard::cell_t* out,
+                                                   size_t count,
+                                                   const TableRule& table) {
+  const auto& rule = kernel_rule<KernelRule>(table);
+  const __m128i two = _mm_set1_epi8(2);
+  const __m128i three = _mm_set1_epi8(3);
+  const __m128i one = _mm_set1_epi8(1);
+
+  size_t c = 0;
+  for (; c + 16 <= count; c += 16) {
+    const __m128i center = load_sse2(mid + c);
+    __m128i sum = _mm_add_epi8(load_sse2(up + c - 1), load_sse2(up + c));
+    sum = _mm_add_epi8(sum, load_sse2(up + c + 1));
+    sum = _mm_add_epi8(sum, load_sse2(mid + c - 1));
+    sum = _mm_add_epi8(sum, load_sse2(mid + c + 1));
+    sum = _mm_add_epi8(sum, load_sse2(down + c - 1));
+    sum = _mm_add_epi8(sum, load_sse2(down + c));
+    sum = _mm_add_epi8(sum, load_sse2(down + c + 1));
+
+    if constexpr (std::is_same_v<KernelRule, ConwayRule>) {
+      /// B3/S23: born or kept with 3 neighbors, kept with 2.
+      const __m128i born = _mm_and_si128(_mm_cmpeq_epi8(sum, three), one);
+      const __m128i kept = _mm_and_si128(_mm_cmpeq_epi8(sum, two), center);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + c), _mm_or_si128(born, kept));
+    } else {
+      __m128i born = _mm_setzero_si128();
+      __m128i kept = _mm_setzero_si128();
+      for (unsigned n = 0; n <= 8; ++n) {
+        const __m128i equal = _mm_cmpeq_epi8(sum, _mm_set1_epi8(static_cast<char>(n)));
+        if ((rule.birth >> n) & 1U) { born = _mm_or_si128(born, equal); }
+        if ((rule.survival >> n) & 1U) { kept = _mm_or_si128(kept, equal); }
+      }
+      /// Born where the center is dead, kept where it is alive.
+      const __m128i alive = _mm_cmpeq_epi8(center, one);
+      const __m128i next = _mm_or_si128(_mm_andnot_si128(alive, born), _mm_and_si128(alive, kept));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + c), _mm_and_si128(next, one));
+    }
+  }
+  step_row_scalar<KernelRule>(up + c, mid + c, down + c, out + c, count - c, table);
+}
+
+/*!
+ * AVX2 kernel, 32 cells per iteration.
+ * The rules are tested as in the SSE2 kernel.
+ */
+template <typename KernelRule>
+__attribute__((target("avx2"))) void step_row_avx2(const ByteBoard::cell_t* up,
+                                                   const ByteBoard::cell_t* mid,
+                                                   const ByteBoard::cell_t* down,
+                                                   ByteBoard::cell_t* out,
+                                                   size_t count,
+                                                   const TableRule& table) {
+  const auto& rule = kernel_rule<KernelRule>(table);
+  const __m256i two = _mm256_set1_epi8(2);
+  const __m256i three = _mm256_set1_epi8(3);
+  const __m256i one = _mm256_set1_epi8(1);
+
+  size_t c = 0;
+  for (; c + 32 <= count; c += 32) {
+    const __m256i center = load_avx2(mid + c);
+    __m256i sum = _mm256_add_epi8(load_avx2(up + c - 1), load_avx2(up + c));
+    sum = _mm256_add_epi8(sum, load_avx2(up + c + 1));
+    sum = _mm256_add_epi8(sum, load_avx2(mid + c - 1));
+    sum = _mm256_add_epi8(sum, load_avx2(mid + c + 1));
+    sum = _mm256_add_epi8(sum, load_avx2(down + c - 1));
+    sum = _mm256_add_epi8(sum, load_avx2(down + c));
+    sum = _mm256_add_epi8(sum, load_avx2(down + c + 1));
+
+    if constexpr (std::is_same_v<KernelRule, ConwayRule>) {
+      /// B3/S23: born or kept with 3 neighbors, kept with 2.
+      const __m256i born = _mm256_and_si256(_mm256_cmpeq_epi8(sum, three), one);
+      const __m256i kept = _mm256_and_si256(_mm256_cmpeq_epi8(sum, two), center);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + c), _mm256_or_si256(born, kept));
+    } else {
+      __m256i born = _mm256_setzero_si256();
+      __m256i kept = _mm256_setzero_si256();
+      for (unsigned n = 0; n <= 8; ++n) {
+        const __m256i equal = _mm256_cmpeq_epi8(sum, _mm256_set1_epi8(static_cast<char>(n)));
+        if ((rule.birth >> n) & 1U) { born = _mm256_or_si256(born, equal); }
+        if ((rule.survival >> n) & 1U) { kept = _mm256_or_si256(kept, equal); }
+      }
+      /// Born where the center is dead, kept where it is alive.
+      const __m256i alive = _mm256_cmpeq_epi8(center, one);
+      const __m256i next = _mm256_or_si256(_mm256_andnot_si256(alive, born), _mm256_and_si256(alive, kept));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + c), _mm256_and_si256(next, one));
+    }
+  }
+  step_row_sse2<KernelRule>(up + c, mid + c, down + c, out + c, count - c, table);
+}
+#endif
+}  // namespace
+
+/// Constructor, picks the fastest kernel the processor supports.
+ByteBoard::ByteBoard() { set_kernel("auto"); }
+
+/*!
+ * Selects the kernel used to step each row.
+ * @param name "auto" for the fastest one supported, or "avx2", "sse2" or "scalar".
+ * @return true if the kernel is supported by this processor, false otherwise.
+ */
+bool ByteBoard::set_kernel(const std::string& name) {
+#ifdef LIFE_X86_KERNELS
+  __builtin_cpu_init();
+  const bool has_avx2 = __builtin_cpu_supports("avx2");
+  const bool has_sse2 = __builtin_cpu_supports("sse2");
+
+  if ((name == "auto" || name == "avx2") && has_avx2) {
+    m_kernel_name = "avx2";
+    select_kernel();
+    return true;
+  }
+  if ((name == "auto" || name == "sse2") && has_sse2) {
+    m_kernel_name = "sse2";
+    select_kernel();
+    return true;
+  }
+#endif
+  if (name == "auto" || name == "scalar") {
+    m_kernel_name = "scalar";
+    select_kernel();
+    return true;
+  }
+  return false;
+}
+
+/*!
+ * Selects the rule of the next steps.
+ * @param rule The rule of the simulation.
+ * @return true, every rule is supported.
+ */
+bool ByteBoard::set_rule(const Rule& rule) {
+  m_rule = rule;
+  m_table = TableRule(rule);
+  select_kernel();
+  return true;
+}
+
+/*!
+ * Selects the kernel of the instruction set in use for the rule: each static
+ * rule (B3/S23, HighLife, Seeds) has its own kernels, any other rule goes
+ * through the table ones.
+ */
+void ByteBoard::select_kernel() {
+  with_rule(m_rule, [this](const auto& rule) {
+    using KernelRule = std::decay_t<decltype(rule)>;
+#ifdef LIFE_X86_KERNELS
+    if (m_kernel_name == "avx2") {
+      m_kernel = step_row_avx2<KernelRule>;
+      return;
+    }
+    if (m_kernel_name == "sse2") {
+      m_kernel = step_row_sse2<KernelRule>;
+      return;
+    }
+#endif
+    m_kernel = step_row_scalar<KernelRule>;
+  });
+}
+
+/*!
+ * Copies the alive cells of a board.
+ * @param cfg The board to be copied.
+ */
+void ByteBoard::load(const LifeCfg& cfg) {
+  m_rows = cfg.m_rows;
+  m_cols = cfg.m_cols;
+  m_cells.assign((m_rows + 2) * (m_cols + 2), 0);
+  m_next.assign(m_cells.size(), 0);
+
+  for (size_t r = 1; r <= m_rows; ++r) {
+    for (size_t c = 1; c <= m_cols; ++c) {
+      m_cells[r * (m_cols + 2) + c] = cfg.get_cell(r, c).is_alive;
+    }
+  }
+}
+
+/*!
+ * Writes the current generation into the board cells.
+ * @param cfg The board that receives the current generation.
+ */
+void ByteBoard::store(LifeCfg& cfg) {
+  for (size_t r = 1; r <= m_rows; ++r) {
+    for (size_t c = 1; c <= m_cols; ++c) {
+      cfg.set_alive(r, c, m_cells[r * (m_cols + 2) + c] != 0);
+    }
+  }
+}
+
+/*!
+ * Counts the alive cells.
+ * @return The number of alive cells.
+ */
+size_t ByteBoard::population() const {
+  return std::accumulate(m_cells.begin(), m_cells.end(), size_t{ 0 });
+}
+
+/*!
+ * Computes the next generation, splitting the rows in bands among the
+ * threads of the pool, if there is one.
+ * On a torus the ghost border holds the opposite edges while stepping, and
+ * is killed again afterwards so population() only counts the board.
+ */
+void ByteBoard::step() {
+  if (m_topology == e_topology::TORUS) { wrap_border(m_cells.data(), m_rows, m_cols); }
+
+  if (m_pool != nullptr) {
+    m_pool->for_each_band(1, m_rows + 1, [this](size_t first, size_t last) { step_rows(first, last); });
+  } else {
+    step_rows(1, m_rows + 1);
+  }
+
+  if (m_topology == e_topology::TORUS) { clear_border(m_cells.data(), m_rows, m_cols); }
+  m_cells.swap(m_next);
+}
+
+/*!
+ * Computes the next generation of the rows in [first, last) into m_next.
+ * The kernel receives the rows starting at column 1; the ghost columns make
+ * the reads at column - 1 and column + 1 always valid.
+ * @param first First row to be computed.
+ * @param last One past the last row to be computed.
+ */
+void ByteBoard::step_rows(size_t first, size_t last) {
+  const size_t expanded_cols = m_cols + 2;
+
+  for (size_t r = first; r < last; ++r) {
+    m_kernel(m_cells.data() + (r - 1) * expanded_cols + 1,
+             m_cells.data() + r * expanded_cols + 1,
+             m_cells.data() + (r + 1) * expanded_cols + 1,
+             m_next.data() + r * expanded_cols + 1,
+             m_cols,
+             m_table);
+  }
+}
+
+}  // namespace life
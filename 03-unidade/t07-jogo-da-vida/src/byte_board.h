@@ -0,0 +1,74 @@
+#ifndef BYTE_BOARD_H
+#define BYTE_BOARD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "engine.h"
+
+namespace life {
+
+/*!
+ * Dense life board with one byte per cell, stepped by vectorized kernels.
+ *
+ * Cells use the same coordinates as the expanded board of `LifeCfg`, with a
+ * dead ghost border, so a row of neighbor sums is just eight byte rows
+ * (shifted by one column to each side) added together. The sum and the
+ * rule are computed 32 (AVX2) or 16 (SSE2) cells at a time; the kernel is
+ * chosen at runtime from what the processor supports, with a portable
+ * scalar kernel as fallback. B3/S23 has kernels of its own; other rules
+ * compare the sums with each neighbor count of their masks, folded at
+ * compile time for HighLife and Seeds.
+ */
+class ByteBoard : public Engine {
+public:
+  //=== Alias
+  typedef uint8_t cell_t;  //!< Type of a cell, 1 if alive and 0 otherwise.
+  /// Computes the next state of `count` cells of a row, given the rows around it and the rule.
+  typedef void (*kernel_t)(const cell_t* up, const cell_t* mid, const cell_t* down, cell_t* out, size_t count,
+                           const TableRule& rule);
+
+  //=== Special members
+  /// Constructor, picks the fastest kernel the processor supports.
+  ByteBoard();
+  /// Destructor
+  ~ByteBoard() override = default;
+
+  //=== Engine interface.
+  /// Copies the alive cells of a board.
+  void load(const LifeCfg& cfg) override;
+  /// Computes the next generation, a row at a time.
+  void step() override;
+  /// Writes the current generation into the board cells.
+  void store(LifeCfg& cfg) override;
+  /// Counts the alive cells.
+  [[nodiscard]] size_t population() const override;
+  /// Selects the rule of the next steps, and the kernels for it.
+  bool set_rule(const Rule& rule) override;
+
+  //=== Attribute accessors members.
+  /// Selects a kernel by name ("auto", "avx2", "sse2" or "scalar"), returning false if unsupported.
+  bool set_kernel(const std::string& name);
+  /// Name of the kernel in use.
+  [[nodiscard]] const std::string& kernel_name() const { return m_kernel_name; }
+
+private:
+  /// Computes the next generation of the rows in [first, last).
+  void step_rows(size_t first, size_t last);
+  /// Selects the kernel of the instruction set in use for the rule.
+  void select_kernel();
+
+  size_t m_rows{ 0 };           //!< Number of rows in the game board.
+  size_t m_cols{ 0 };           //!< Number of columns in the game board.
+  std::vector<cell_t> m_cells;  //!< Current generation, expanded board.
+  std::vector<cell_t> m_next;   //!< Buffer where the next generation is computed.
+  kernel_t m_kernel;            //!< Kernel used to step each row.
+  TableRule m_table{ Rule() };  //!< State table of the rule, for the table kernels.
+  std::string m_kernel_name;    //!< Name of the kernel in use.
+};
+
+}  // namespace life
+
+#endif  // BYTE_BOARD_H
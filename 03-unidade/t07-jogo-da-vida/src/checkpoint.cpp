@@ -0,0 +1,251 @@
+/*!
+ * Checkpoint and CheckpointWriter implementation.
+ * @file checkpoint.cpp
+ */
+
+#include "checkpoint.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <utility>
+
+namespace life {
+
+namespace {
+/// Identifies a checkpoint file and the version of its layout.
+const char checkpoint_magic[8] = { 'G', 'L', 'I', 'F', 'E', 'C', 'K', '2' };
+
+/// Writes a 64-bit integer.
+void put(std::ofstream& file, uint64_t value) { file.write(reinterpret_cast<const char*>(&value), sizeof value); }
+
+/// Writes an array of 64-bit words.
+void put(std::ofstream& file, const std::vector<uint64_t>& words) {
+  file.write(reinterpret_cast<const char*>(words.data()), static_cast<std::streamsize>(words.size() * sizeof(uint64_t)));
+}
+
+/// Reads a 64-bit integer.
+uint64_t get(std::ifstream& file) {
+  uint64_t value = 0;
+  file.read(reinterpret_cast<char*>(&value), sizeof value);
+  return value;
+}
+
+/// Reads an array of 64-bit words.
+void get(std::ifstream& file, std::vector<uint64_t>& words, size_t count) {
+  words.resize(count);
+  file.read(reinterpret_cast<char*>(words.data()), static_cast<std::streamsize>(count * sizeof(uint64_t)));
+}
+
+/// Writes a history segment: its first index, keyframe, deltas and the end of each delta.
+void put(std::ofstream& file, const HistoryStore::Segment& segment) {
+  put(file, segment.first);
+  put(file, segment.keyframe.size());
+  put(file, segment.keyframe);
+  put(file, segment.deltas.size());
+  put(file, segment.deltas);
+  put(file, segment.ends.size());
+  for (const size_t end : segment.ends) { put(file, end); }
+}
+
+/// Reads a history segment, telling whether it is complete and its keyframe has the given size (any for zero).
+bool get(std::ifstream& file, HistoryStore::Segment& segment, size_t words) {
+  segment.first = get(file);
+  const uint64_t size = get(file);
+  if (!file || (words != 0 && size != words)) { return false; }
+  get(file, segment.keyframe, size);
+  get(file, segment.deltas, get(file));
+  const uint64_t ends = get(file);
+  if (!file || ends > segment.deltas.size()) { return false; }
+  segment.ends.resize(ends);
+  for (auto& end : segment.ends) { end = get(file); }
+  return static_cast<bool>(file);
+}
+}  // namespace
+
+/*!
+ * Writes a checkpoint file. The checkpoint is written to a temporary file
+ * first and then renamed, so a crash while writing keeps the previous one.
+ * The checkpoint must carry the whole history (history_begin equal to zero).
+ * The history is written as it is kept, so the file grows with the
+ * compressed history and not with the number of generations times the board.
+ * @param filename Name of the checkpoint file.
+ * @return true if the file was written, false otherwise.
+ */
+bool Checkpoint::save(const std::string& filename) const {
+  const std::string temporary = filename + ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) { return false; }
+
+    file.write(checkpoint_magic, sizeof checkpoint_magic);
+    put(file, rows);
+    put(file, cols);
+    put(file, generation);
+    put(file, rule.size());
+    file.write(rule.data(), static_cast<std::streamsize>(rule.size()));
+    put(file, bits);
+    put(file, plane.size());
+    put(file, plane);
+    put(file, static_cast<uint64_t>(plane_keys));
+    put(file, history_generations.size());
+    put(file, history_generations);
+    put(file, history_hashes);
+    put(file, history.size());
+    put(file, history.segments().size());
+    for (const auto& segment : history.segments()) { put(file, segment); }
+    if (!file) { return false; }
+  }
+  return std::rename(temporary.c_str(), filename.c_str()) == 0;
+}
+
+/*!
+ * Reads a checkpoint file.
+ * @param filename Name of the checkpoint file.
+ * @return true if the file is a complete checkpoint, false otherwise.
+ */
+bool Checkpoint::load(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.is_open()) { return false; }
+
+  char magic[sizeof checkpoint_magic] = {};
+  file.read(magic, sizeof magic);
+  if (!file || !std::equal(magic, magic + sizeof magic, checkpoint_magic)) { return false; }
+
+  rows = get(file);
+  cols = get(file);
+  generation = get(file);
+  const uint64_t length = get(file);
+  if (!file || length > 64) { return false; }
+  rule.assign(length, ' ');
+  file.read(rule.data(), static_cast<std::streamsize>(length));
+  const size_t words = (rows * cols + 63) / 64;
+  get(file, bits, words);
+  get(file, plane, get(file));
+  plane_keys = get(file) != 0;
+
+  const uint64_t count = get(file);
+  if (!file) { return false; }
+  history_begin = 0;
+  get(file, history_generations, count);
+  get(file, history_hashes, count);
+
+  const uint64_t size = get(file);
+  const uint64_t segments = get(file);
+  std::deque<HistoryStore::Segment> kept;
+  for (uint64_t i = 0; i < segments && file; ++i) {
+    kept.emplace_back();
+    if (!get(file, kept.back(), plane_keys ? 0 : words)) { return false; }
+  }
+  if (!file || size != count) { return false; }
+  history.assign(std::move(kept), size);
+  history_kept = history.first();
+  return true;
+}
+
+/*!
+ * Starts the writer thread.
+ * @param filename File that receives the checkpoints.
+ */
+CheckpointWriter::CheckpointWriter(std::string filename)
+    : m_filename(std::move(filename)), m_thread(&CheckpointWriter::writer_loop, this) {}
+
+/// Destructor, writes the pending checkpoint and stops the thread.
+CheckpointWriter::~CheckpointWriter() { finish(); }
+
+/*!
+ * Hands a checkpoint to the writer thread, without waiting for it to be written.
+ * @param checkpoint The checkpoint, with the generations observed since the previous one.
+ */
+void CheckpointWriter::submit(Checkpoint&& checkpoint) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_has_pending) {
+      /// The previous one was not written yet: keep its history and take the new state.
+      merge_history(m_pending, checkpoint);
+      m_pending.generation = checkpoint.generation;
+      m_pending.rows = checkpoint.rows;
+      m_pending.cols = checkpoint.cols;
+      m_pending.bits.swap(checkpoint.bits);
+      m_pending.rule.swap(checkpoint.rule);
+      m_pending.plane.swap(checkpoint.plane);
+      m_pending.plane_keys = checkpoint.plane_keys;
+    } else {
+      m_pending = std::move(checkpoint);
+      m_has_pending = true;
+    }
+  }
+  m_ready.notify_one();
+}
+
+/*!
+ * Appends the observed generations of a checkpoint, and their hashes, to
+ * the history of another, and takes its history segments in place of the
+ * ones they overlap. Segments evicted from the detector's history are
+ * dropped.
+ * @param into The checkpoint that receives the history.
+ * @param from The checkpoint whose history is moved.
+ */
+void CheckpointWriter::merge_history(Checkpoint& into, Checkpoint& from) {
+  /// A history that starts over (the detector was cleared) replaces ours.
+  if (from.history_begin == 0) {
+    into.history_begin = 0;
+    into.history_generations.clear();
+    into.history_hashes.clear();
+    into.history.clear();
+  }
+  into.history_generations.resize(std::min(from.history_begin - into.history_begin, into.history_generations.size()));
+  into.history_generations.insert(into.history_generations.end(), from.history_generations.begin(),
+                                  from.history_generations.end());
+  into.history_hashes.resize(into.history_generations.size() - from.history_generations.size());
+  into.history_hashes.insert(into.history_hashes.end(), from.history_hashes.begin(), from.history_hashes.end());
+  into.history_kept = from.history_kept;
+  into.history.splice(std::move(from.history), from.history_kept);
+}
+
+/*!
+ * Main loop of the writer thread: writes each pending checkpoint, keeping
+ * the compressed history of observed boards between them.
+ */
+void CheckpointWriter::writer_loop() {
+  Checkpoint whole;  //!<- The last checkpoint, with every observed generation and kept segment.
+
+  for (;;) {
+    Checkpoint next;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_ready.wait(lock, [this] { return m_done || m_has_pending; });
+      if (!m_has_pending) { return; }
+      next = std::move(m_pending);
+      m_has_pending = false;
+    }
+
+    merge_history(whole, next);
+    whole.generation = next.generation;
+    whole.rows = next.rows;
+    whole.cols = next.cols;
+    whole.bits.swap(next.bits);
+    whole.rule.swap(next.rule);
+    whole.plane.swap(next.plane);
+    whole.plane_keys = next.plane_keys;
+
+    const bool success = whole.save(m_filename);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++(success ? m_written : m_failed);
+  }
+}
+
+/*!
+ * Writes the pending checkpoint and stops the thread.
+ */
+void CheckpointWriter::finish() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_done = true;
+  }
+  m_ready.notify_all();
+  if (m_thread.joinable()) { m_thread.join(); }
+}
+
+}  // namespace life
@@ -0,0 +1,99 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "history.h"
+
+namespace life {
+
+/*!
+ * State of a simulation, enough to resume it: the board of a generation,
+ * bit-packed, with its rule and, on a plane, every live cell of the plane;
+ * and the state of the stability detector, i.e. the generation and hash of
+ * each observed board and the history of the boards (or plane keys) it
+ * still keeps, as keyframes and deltas.
+ */
+struct Checkpoint {
+  uint64_t generation{ 0 };                      //!< Generation of the board, not observed yet.
+  uint64_t rows{ 0 };                            //!< Number of rows of the board.
+  uint64_t cols{ 0 };                            //!< Number of columns of the board.
+  std::vector<uint64_t> bits;                    //!< Cells in row-major order, 64 per word.
+  std::string rule;                              //!< Rule of the simulation, in B/S notation.
+  std::vector<uint64_t> plane;                   //!< Live cells of the whole plane (Engine::save_plane()), empty if none.
+  bool plane_keys{ false };                      //!< Whether the history holds plane keys instead of boards.
+  size_t history_begin{ 0 };                     //!< Index of the first observed generation carried below.
+  std::vector<uint64_t> history_generations;     //!< Generation of each observed board from history_begin on.
+  std::vector<uint64_t> history_hashes;          //!< Hash of each of those boards.
+  size_t history_kept{ 0 };                      //!< Index of the first observed board not evicted.
+  HistoryStore history;                          //!< Observed boards, bit-packed like bits, as keyframes and deltas.
+
+  /// Writes a checkpoint file, replacing the old one only when the new one is complete.
+  bool save(const std::string& filename) const;
+  /// Reads a checkpoint file.
+  bool load(const std::string& filename);
+};
+
+/*!
+ * Writes checkpoints on a background thread, so the simulation only pays
+ * for copying the board.
+ *
+ * Observed boards never change, so each checkpoint handed to `submit()`
+ * carries only the generations observed since the previous one and the
+ * history segments that may have changed; the writer keeps the rest of the
+ * history, still compressed, and drops the segments evicted by its cap.
+ * When the disk is slower than the checkpoints, a pending checkpoint not
+ * written yet is merged with the new one.
+ */
+class CheckpointWriter {
+public:
+  //=== Special members
+  /// Constructor, starts the writer thread.
+  explicit CheckpointWriter(std::string filename);
+  /// Destructor, writes the pending checkpoint and stops the thread.
+  ~CheckpointWriter();
+  /// A writer owns its thread, so it cannot be copied.
+  CheckpointWriter(const CheckpointWriter&) = delete;
+  /// A writer owns its thread, so it cannot be assigned.
+  CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+  //=== Members
+  /// Hands a checkpoint to the writer thread.
+  void submit(Checkpoint&& checkpoint);
+  /// Writes the pending checkpoint and stops the thread.
+  void finish();
+
+  //=== Attribute accessors members.
+  /// Number of checkpoints written.
+  [[nodiscard]] size_t written() const { return m_written; }
+  /// Number of checkpoints that could not be written.
+  [[nodiscard]] size_t failed() const { return m_failed; }
+  /// File that receives the checkpoints.
+  [[nodiscard]] const std::string& filename() const { return m_filename; }
+
+private:
+  /// Main loop of the writer thread.
+  void writer_loop();
+  /// Appends the observed generations and history segments of a checkpoint to the whole history.
+  static void merge_history(Checkpoint& into, Checkpoint& from);
+
+  std::string m_filename;              //!< File that receives the checkpoints.
+  std::mutex m_mutex;                  //!< Guards the members below.
+  std::condition_variable m_ready;     //!< Signals a pending checkpoint (or the end).
+  Checkpoint m_pending;                //!< Checkpoint waiting to be written.
+  bool m_has_pending{ false };         //!< Whether m_pending holds a checkpoint.
+  bool m_done{ false };                //!< Tells the thread that no checkpoint will be submitted.
+  size_t m_written{ 0 };               //!< Number of checkpoints written.
+  size_t m_failed{ 0 };                //!< Number of checkpoints that could not be written.
+  std::thread m_thread;                //!< The writer thread.
+};
+
+}  // namespace life
+
+#endif  // CHECKPOINT_H
@@ -2,11 +2,16 @@
 #include <iostream>
 
 #include "config.h"
+#include "rule.h"
+
+#include <thread>
 
 /*! This function remove quotes of the paths.
  * @param path File path from which the quotes will be removed.
  */
 void Config::remove_quotes(std::string& path) {
+    if (path.empty()) { return; }
+
     size_t start = 0;
     size_t end = path.size() - 1;
 
@@ -60,6 +65,55 @@ size_t Config::set_max_gen(IniParser &filename) {
 	return number_gen;
 }
 
+/*!
+* This function set the number of rows of the board for RLE and plaintext patterns; by default, 
+* this value is 0, which uses the size of the pattern. A pattern smaller than the board is centered.
+* @param filename Name of the config file.
+* @return Number of rows.
+*/
+size_t Config::set_rows(IniParser &filename) {
+    int n_rows = 0;
+    filename.get_int("", "rows", n_rows);
+
+    if (n_rows < 0) {
+        throw std::invalid_argument("Used a negative value in < rows > when a positive integer or zero was expected.");
+    }
+
+    return static_cast<size_t>(n_rows);
+}
+
+/*!
+* This function set the number of columns of the board for RLE and plaintext patterns; by default,
+* this value is 0, which uses the size of the pattern.
+* @param filename Name of the config file.
+* @return Number of columns.
+*/
+size_t Config::set_cols(IniParser &filename) {
+    int n_cols = 0;
+    filename.get_int("", "cols", n_cols);
+
+    if (n_cols < 0) {
+        throw std::invalid_argument("Used a negative value in < cols > when a positive integer or zero was expected.");
+    }
+
+    return static_cast<size_t>(n_cols);
+}
+
+/*!
+* This function set the file where the last generation is saved, as .rle, .cells or .dat
+* according to its extension; by default, nothing is saved.
+* @param filename Name of the config file.
+* @return The file name, empty for none.
+*/
+std::string Config::set_output_cfg(IniParser &filename) {
+    std::string output;
+    if (!filename.get_string("", "output_cfg", output)) { return ""; }
+
+    remove_quotes(output);
+
+    return output;
+}
+
 /*!
 * This function set if the user wants to generate images; by default, this value is true.
 * @param filename Name of the config file.
@@ -183,6 +237,196 @@ std::string Config::set_path(IniParser &filename) {
     return file_imgs;
 }
 
+/*!
+* This function set the number of threads that encode the images; by default, this value is 2.
+* @param filename Name of the config file.
+* @return Number of encoder threads.
+*/
+size_t Config::set_encoders(IniParser &filename) {
+    int n_encoders;
+    bool informed = filename.get_int("Image", "encoders", n_encoders);  //!<- Show if the data was provided.
+
+    /// Check if input was be informed.
+    if (!informed) {
+        n_encoders = 2;
+    }
+
+    if (n_encoders <= 0) {
+        throw std::invalid_argument("Used a negative value or zero in < encoders > when a positive integer was expected.");
+    }
+
+    return static_cast<size_t>(n_encoders);
+}
+
+/*!
+* This function set how many images may wait to be encoded; by default, this value is 8.
+* When the queue is full the simulation waits for the encoders.
+* @param filename Name of the config file.
+* @return Size of the queue.
+*/
+size_t Config::set_queue_size(IniParser &filename) {
+    int size;
+    bool informed = filename.get_int("Image", "queue_size", size);  //!<- Show if the data was provided.
+
+    /// Check if input was be informed.
+    if (!informed) {
+        size = 8;
+    }
+
+    if (size <= 0) {
+        throw std::invalid_argument("Used a negative value or zero in < queue_size > when a positive integer was expected.");
+    }
+
+    return static_cast<size_t>(size);
+}
+
+/*!
+* This function set the kind of image output; by default, one PNG file per generation.
+* @param filename Name of the config file.
+* @return "png", "apng" or "raw".
+*/
+std::string Config::set_output(IniParser &filename) {
+    std::vector<std::string> outputs = { "png", "apng", "raw" };  //!<- Vector with all outputs.
+
+    std::string name;
+    bool informed = filename.get_string("Image", "output", name);  //!<- Show if the data was provided.
+
+    /// Convert the name to lowercase.
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+
+    /// Check if the output was informed or is valid.
+    if (!informed || std::find(outputs.begin(), outputs.end(), name) == outputs.end()) {
+        if (informed) {
+            std::cout << ">>> The output < " << name << " > is not a valid output." << std::endl;
+            std::cout << ">>> Using the default value [png]." << std::endl;
+        }
+        name = "png";
+    }
+
+    return name;
+}
+
+/*!
+* This function set the name of the animation file, saved inside path; by default, "life.png".
+* @param filename Name of the config file.
+* @return Name of the animation file.
+*/
+std::string Config::set_apng_file(IniParser &filename) {
+    std::string name;
+    bool informed = filename.get_string("Image", "apng_file", name);  //!<- Show if the data was provided.
+
+    /// Check if input was be informed.
+    if (!informed) {
+        name = "life.png";
+    }
+
+    remove_quotes(name);
+
+    return name;
+}
+
+/*!
+* This function set the file or FIFO that receives the raw frames; by default, "-" (the standard output).
+* @param filename Name of the config file.
+* @return Destination of the raw frames.
+*/
+std::string Config::set_raw_target(IniParser &filename) {
+    std::string target;
+    bool informed = filename.get_string("Image", "raw_target", target);  //!<- Show if the data was provided.
+
+    /// Check if input was be informed.
+    if (!informed) {
+        target = "-";
+    }
+
+    remove_quotes(target);
+
+    return target;
+}
+
+/*!
+* This function set the color mode of the PNG images; by default, 1-bit palette images.
+* @param filename Name of the config file.
+* @return "palette" or "rgba".
+*/
+std::string Config::set_color_mode(IniParser &filename) {
+    std::vector<std::string> modes = { "palette", "rgba" };  //!<- Vector with all color modes.
+
+    std::string name;
+    bool informed = filename.get_string("Image", "color_mode", name);  //!<- Show if the data was provided.
+
+    /// Convert the name to lowercase.
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+
+    /// Check if the color mode was informed or is valid.
+    if (!informed || std::find(modes.begin(), modes.end(), name) == modes.end()) {
+        if (informed) {
+            std::cout << ">>> The color mode < " << name << " > is not a valid color mode." << std::endl;
+            std::cout << ">>> Using the default value [palette]." << std::endl;
+        }
+        name = "palette";
+    }
+
+    return name;
+}
+
+/*!
+* This function set the LZ77 window size of the PNG compression; by default, this value is 2048.
+* Larger windows find more repetitions, but are slower.
+* @param filename Name of the config file.
+* @return Window size.
+*/
+unsigned Config::set_deflate_window(IniParser &filename) {
+    int window;
+    bool informed = filename.get_int("Image", "deflate_window", window);  //!<- Show if the data was provided.
+
+    /// Check if input was be informed.
+    if (!informed) {
+        window = 2048;
+    }
+
+    /// Check if the window is a power of two up to 32768.
+    if (window <= 0 || window > 32768 || (window & (window - 1)) != 0) {
+        throw std::invalid_argument("Used a value in < deflate_window > when a power of two up to 32768 was expected.");
+    }
+
+    return static_cast<unsigned>(window);
+}
+
+/*!
+* This function set the match length that stops the search of the PNG compression; by default, this value is 128.
+* Smaller values are faster, 258 compresses the most.
+* @param filename Name of the config file.
+* @return Match length.
+*/
+unsigned Config::set_deflate_nicematch(IniParser &filename) {
+    int length;
+    bool informed = filename.get_int("Image", "deflate_nicematch", length);  //!<- Show if the data was provided.
+
+    /// Check if input was be informed.
+    if (!informed) {
+        length = 128;
+    }
+
+    if (length < 3 || length > 258) {
+        throw std::invalid_argument("Used a value in < deflate_nicematch > when an integer from 3 to 258 was expected.");
+    }
+
+    return static_cast<unsigned>(length);
+}
+
+/*!
+* This function set whether the PNG compression uses lazy matching; by default, it is used.
+* @param filename Name of the config file.
+* @return Bool of lazy matching.
+*/
+bool Config::set_deflate_lazy(IniParser &filename) {
+    bool lazy = true;
+    filename.get_bool("Image", "deflate_lazy", lazy);
+
+    return lazy;
+}
+
 /*!
 * This function set the number of frames per second; by default, this value is 2.
 * @param filename Name of the config file.
@@ -206,6 +450,518 @@ int Config::set_fps(IniParser &filename) {
     return fps;
 }
 
+/*!
+* This function set how the generations are shown in text mode; by default, this value is "scroll".
+* @param filename Name of the config file.
+* @return Name of the text mode.
+*/
+std::string Config::set_text_mode(IniParser &filename) {
+    std::vector<std::string> modes = { "scroll", "ansi", "diff" };  //!<- Vector with all text modes.
+
+    std::string name;
+    bool informed = filename.get_string("Text", "mode", name);  //!<- Show if the data was provided.
+
+    /// Convert the name to lowercase.
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+
+    /// Check if the mode was informed or is valid.
+    if (!informed || std::find(modes.begin(), modes.end(), name) == modes.end()) {
+        if (informed) {
+            std::cout << ">>> The text mode < " << name << " > is not a valid text mode." << std::endl;
+            std::cout << ">>> Using the default value [scroll]." << std::endl;
+        }
+        name = "scroll";
+    }
+
+    return name;
+}
+
+/*!
+* This function set whether the frames of the text output that run late are skipped; by default, they are not.
+* @param filename Name of the config file.
+* @return Bool of drop_frames.
+*/
+bool Config::set_drop_frames(IniParser &filename) {
+    bool drop = false;
+    filename.get_bool("Text", "drop_frames", drop);
+
+    return drop;
+}
+
+/*!
+* This function set the glyphs of the text output; by default, this value is "bullet" (a cell per character).
+* "half" packs 2x1 cells per character and "braille" packs 4x2 cells per character.
+* @param filename Name of the config file.
+* @return Name of the glyph.
+*/
+std::string Config::set_glyph(IniParser &filename) {
+    std::vector<std::string> glyphs = { "bullet", "half", "braille" };  //!<- Vector with all glyphs.
+
+    std::string name;
+    bool informed = filename.get_string("Text", "glyph", name);  //!<- Show if the data was provided.
+
+    /// Convert the name to lowercase.
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+
+    /// Check if the glyph was informed or is valid.
+    if (!informed || std::find(glyphs.begin(), glyphs.end(), name) == glyphs.end()) {
+        if (informed) {
+            std::cout << ">>> The glyph < " << name << " > is not a valid glyph." << std::endl;
+            std::cout << ">>> Using the default value [bullet]." << std::endl;
+        }
+        name = "bullet";
+    }
+
+    return name;
+}
+
+/*!
+* This function set how many cells of each side a glyph dot covers; by default, this value is 1.
+* @param filename Name of the config file.
+* @return The zoom.
+*/
+size_t Config::set_zoom(IniParser &filename) {
+    int n_zoom;
+    bool informed = filename.get_int("Text", "zoom", n_zoom);  //!<- Show if the data was provided.
+
+    /// Check if input was be informed.
+    if (!informed) {
+        n_zoom = 1;
+    }
+
+    if (n_zoom <= 0) {
+        throw std::invalid_argument("Used a negative value or zero in < zoom > when a positive integer was expected.");
+    }
+
+    return static_cast<size_t>(n_zoom);
+}
+
+/*!
+* This function set a coordinate or size of the part of the board shown in text mode; by default, this value is 0
+* (the first row or column, or the size that fits the terminal).
+* @param filename Name of the config file.
+* @param key The key: view_row, view_col, view_rows or view_cols.
+* @return The value.
+*/
+size_t Config::set_view(IniParser &filename, const std::string &key) {
+    int value;
+    bool informed = filename.get_int("Text", key, value);  //!<- Show if the data was provided.
+
+    /// Check if input was be informed.
+    if (!informed) {
+        value = 0;
+    }
+
+    if (value < 0) {
+        throw std::invalid_argument("Used a negative value in < " + key + " > when a positive integer or zero was expected.");
+    }
+
+    return static_cast<size_t>(value);
+}
+
+/*!
+* This function set the engine used to compute the generations; by default, this value is "cell".
+* @param filename Name of the config file.
+* @return Name of the engine.
+*/
+std::string Config::set_engine(IniParser &filename) {
+    std::vector<std::string> engines = { "cell", "bitpacked", "sparse", "hashlife", "simd" };  //!<- Vector with all engines.
+
+    std::string name;
+    bool informed = filename.get_string("Simulation", "engine", name);  //!<- Show if the data was provided.
+
+    /// Convert the name to lowercase.
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+
+    /// Check if the engine was informed or is valid.
+    if (!informed || std::find(engines.begin(), engines.end(), name) == engines.end()) {
+
+        if (!informed) { std::cout << ">>> The < engine > not informed in [config/glife.ini]." << std::endl; }
+        else { std::cout << ">>> The engine < " << name << " > is not a valid engine." << std::endl; }
+
+        std::cout << ">>> Using the default value [cell]." << std::endl;
+        name = "cell";
+    }
+
+    return name;
+}
+
+/*!
+* This function set the number of threads that compute each generation; by default, this value is 1.
+* Zero uses one thread per available core.
+* @param filename Name of the config file.
+* @return Number of threads.
+*/
+size_t Config::set_threads(IniParser &filename) {
+    int n_threads;
+    bool informed = filename.get_int("Simulation", "threads", n_threads);  //!<- Show if the data was provided.
+
+    /// Check if input was be informed.
+    if (!informed) {
+        std::cout << ">>> The < threads > not informed in [config/glife.ini]." << std::endl;
+        std::cout << ">>> Using the default value [1]." << std::endl;
+        n_threads = 1;
+    }
+
+    if (n_threads < 0) {
+        throw std::invalid_argument("Used a negative value in < threads > when a positive integer or zero was expected.");
+    }
+
+    /// Use every available core.
+    if (n_threads == 0) {
+        n_threads = std::max(1U, std::thread::hardware_concurrency());
+        std::cout << ">>> Using one thread per core [" << n_threads << "]." << std::endl;
+    }
+
+    return static_cast<size_t>(n_threads);
+}
+
+/*!
+* This function set the first generation shown, skipping the previous ones; by default, this value is 1.
+* @param filename Name of the config file.
+* @return The first generation.
+*/
+size_t Config::set_jump_to(IniParser &filename) {
+    int generation;
+    bool informed = filename.get_int("Simulation", "jump_to", generation);  //!<- Show if the data was provided.
+
+    /// Check if input was be informed.
+    if (!informed || generation == 0) {
+        generation = 1;
+    }
+
+    if (generation < 0) {
+        throw std::invalid_argument("Used a negative value in < jump_to > when a positive integer or zero was expected.");
+    }
+
+    if (max_gen != 0 && static_cast<size_t>(generation) > max_gen) {
+        throw std::invalid_argument("The < jump_to > generation is greater than < max_gen >.");
+    }
+
+    return static_cast<size_t>(generation);
+}
+
+/*!
+* This function set how many nodes the HashLife engine keeps before discarding unused ones; by default, this value is 1000000.
+* @param filename Name of the config file.
+* @return Maximum number of nodes.
+*/
+size_t Config::set_node_cache(IniParser &filename) {
+    int nodes;
+    bool informed = filename.get_int("Simulation", "node_cache", nodes);  //!<- Show if the data was provided.
+
+    /// Check if input was be informed.
+    if (!informed) {
+        nodes = 1000000;
+    }
+
+    if (nodes <= 0) {
+        throw std::invalid_argument("Used a negative value or zero in < node_cache > when a positive integer was expected.");
+    }
+
+    return static_cast<size_t>(nodes);
+}
+
+/*!
+* This function set the vector kernel used by the simd engine; by default, this value is "auto".
+* @param filename Name of the config file.
+* @return Name of the kernel.
+*/
+std::string Config::set_kernel(IniParser &filename) {
+    std::vector<std::string> kernels = { "auto", "avx2", "sse2", "scalar" };  //!<- Vector with all kernels.
+
+    std::string name;
+    bool informed = filename.get_string("Simulation", "kernel", name);  //!<- Show if the data was provided.
+
+    /// Convert the name to lowercase.
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+
+    /// Check if the kernel was informed or is valid.
+    if (!informed || std::find(kernels.begin(), kernels.end(), name) == kernels.end()) {
+        if (informed) {
+            std::cout << ">>> The kernel < " << name << " > is not a valid kernel." << std::endl;
+            std::cout << ">>> Using the default value [auto]." << std::endl;
+        }
+        name = "auto";
+    }
+
+    return name;
+}
+
+/*!
+* This function set what lies beyond the edges of the board; by default, this value is "bounded".
+* @param filename Name of the config file.
+* @return Name of the topology.
+*/
+std::string Config::set_topology(IniParser &filename) {
+    std::vector<std::string> topologies = { "bounded", "torus", "plane" };  //!<- Vector with all topologies.
+
+    std::string name;
+    bool informed = filename.get_string("Simulation", "topology", name);  //!<- Show if the data was provided.
+
+    /// Convert the name to lowercase.
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+
+    /// Check if the topology was informed or is valid.
+    if (!informed || std::find(topologies.begin(), topologies.end(), name) == topologies.end()) {
+        if (informed) {
+            std::cout << ">>> The topology < " << name << " > is not a valid topology." << std::endl;
+            std::cout << ">>> Using the default value [bounded]." << std::endl;
+        }
+        name = "bounded";
+    }
+
+    return name;
+}
+
+/*!
+* This function set the rule of the simulation, in B/S notation; by default, this value is empty
+* (the rule of a RLE pattern, or B3/S23).
+* @param filename Name of the config file.
+* @return The rule, written as "B3/S23".
+*/
+std::string Config::set_rule(IniParser &filename) {
+    std::string name;
+    bool informed = filename.get_string("Simulation", "rule", name);  //!<- Show if the data was provided.
+
+    remove_quotes(name);
+
+    /// Check if input was be informed.
+    if (!informed || name.empty()) {
+        return "";
+    }
+
+    /// Check if the rule is valid.
+    Rule parsed;
+    if (!Rule::parse(name, parsed)) {
+        std::cout << ">>> The rule < " << name << " > is not a valid rule." << std::endl;
+        std::cout << ">>> Using the default value [B3/S23]." << std::endl;
+        return "B3/S23";
+    }
+
+    return parsed.to_string();
+}
+
+/*!
+* This function set how many generations separate two checkpoints; by default, this value is 0 (no checkpoints).
+* @param filename Name of the config file.
+* @return Number of generations between checkpoints.
+*/
+size_t Config::set_checkpoint_every(IniParser &filename) {
+    int generations;
+    bool informed = filename.get_int("Simulation", "checkpoint_every", generations);  //!<- Show if the data was provided.
+
+    /// Check if input was be informed.
+    if (!informed) {
+        generations = 0;
+    }
+
+    if (generations < 0) {
+        throw std::invalid_argument("Used a negative value in < checkpoint_every > when a positive integer or zero was expected.");
+    }
+
+    return static_cast<size_t>(generations);
+}
+
+/*!
+* This function set the file where the checkpoints are saved; by default, "glife.ckpt".
+* @param filename Name of the config file.
+* @return Name of the checkpoint file.
+*/
+std::string Config::set_checkpoint_file(IniParser &filename) {
+    std::string name;
+    bool informed = filename.get_string("Simulation", "checkpoint_file", name);  //!<- Show if the data was provided.
+
+    remove_quotes(name);
+
+    /// Check if input was be informed.
+    if (!informed || name.empty()) {
+        name = "glife.ckpt";
+    }
+
+    return name;
+}
+
+/*!
+* This function set how many generations lie between two whole boards of the history; by default, this value is 64.
+* @param filename Name of the config file.
+* @return The keyframe interval.
+*/
+size_t Config::set_history_keyframe(IniParser &filename) {
+    int every;
+    bool informed = filename.get_int("History", "keyframe_every", every);  //!<- Show if the data was provided.
+
+    /// Check if input was be informed.
+    if (!informed) {
+        every = 64;
+    }
+
+    if (every <= 0) {
+        throw std::invalid_argument("Used a negative value or zero in < keyframe_every > when a positive integer was expected.");
+    }
+
+    return static_cast<size_t>(every);
+}
+
+/*!
+* This function set the memory cap, in MiB, of the history of boards; by default, this value is 0 (no limit).
+* @param filename Name of the config file.
+* @return The memory cap in MiB.
+*/
+size_t Config::set_history_memory(IniParser &filename) {
+    int mib;
+    bool informed = filename.get_int("History", "memory", mib);  //!<- Show if the data was provided.
+
+    /// Check if input was be informed.
+    if (!informed) {
+        mib = 0;
+    }
+
+    if (mib < 0) {
+        throw std::invalid_argument("Used a negative value in < memory > when a positive integer or zero was expected.");
+    }
+
+    return static_cast<size_t>(mib);
+}
+
+/*!
+* This function set the directory that receives past generations when stability is found; by default, none.
+* @param filename Name of the config file.
+* @return Name of the directory, empty for none.
+*/
+std::string Config::set_history_dump(IniParser &filename) {
+    std::string name;
+    bool informed = filename.get_string("History", "dump", name);  //!<- Show if the data was provided.
+
+    remove_quotes(name);
+
+    /// Check if input was be informed.
+    if (!informed) {
+        name = "";
+    }
+
+    return name;
+}
+
+/*!
+* This function set whether every kept generation is dumped, instead of only the cycle; by default, only the cycle.
+* @param filename Name of the config file.
+* @return Bool of dump_all.
+*/
+bool Config::set_history_dump_all(IniParser &filename) {
+    bool all = false;
+    filename.get_bool("History", "dump_all", all);
+
+    return all;
+}
+
+/*!
+* This function set how many simulations of a batch run at once; by default, this value is 0 (one per core).
+* @param filename Name of the config file.
+* @return Number of batch workers.
+*/
+size_t Config::set_batch_workers(IniParser &filename) {
+    int n_workers;
+    bool informed = filename.get_int("Batch", "workers", n_workers);  //!<- Show if the data was provided.
+
+    /// Check if input was be informed.
+    if (!informed) {
+        n_workers = 0;
+    }
+
+    if (n_workers < 0) {
+        throw std::invalid_argument("Used a negative value in < workers > when a positive integer or zero was expected.");
+    }
+
+    /// Use every available core.
+    if (n_workers == 0) {
+        n_workers = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    return static_cast<size_t>(n_workers);
+}
+
+/*!
+* This function set the CSV file that receives the summary of a batch; by default, "batch.csv".
+* @param filename Name of the config file.
+* @return Name of the summary file.
+*/
+std::string Config::set_batch_summary(IniParser &filename) {
+    std::string name;
+    bool informed = filename.get_string("Batch", "summary", name);  //!<- Show if the data was provided.
+
+    remove_quotes(name);
+
+    /// Check if input was be informed.
+    if (!informed || name.empty()) {
+        name = "batch.csv";
+    }
+
+    return name;
+}
+
+/*!
+* This function set how many populations each curve of the batch summary holds; by default, this value is 32.
+* @param filename Name of the config file.
+* @return Number of points, zero for every generation.
+*/
+size_t Config::set_curve_points(IniParser &filename) {
+    int points;
+    bool informed = filename.get_int("Batch", "curve_points", points);  //!<- Show if the data was provided.
+
+    /// Check if input was be informed.
+    if (!informed) {
+        points = 32;
+    }
+
+    if (points < 0) {
+        throw std::invalid_argument("Used a negative value in < curve_points > when a positive integer or zero was expected.");
+    }
+
+    return static_cast<size_t>(points);
+}
+
+/*!
+* This function set the file that receives the statistics of each generation; by default, none.
+* A name ending with ".json" selects JSON, any other name selects CSV.
+* @param filename Name of the config file.
+* @return Name of the statistics file, empty for none.
+*/
+std::string Config::set_stats_file(IniParser &filename) {
+    std::string name;
+    bool informed = filename.get_string("Stats", "file", name);  //!<- Show if the data was provided.
+
+    remove_quotes(name);
+
+    /// Check if input was be informed.
+    if (!informed) {
+        name = "";
+    }
+
+    return name;
+}
+
+/*!
+* This function set how many generations the statistics keep; by default, this value is 100000.
+* @param filename Name of the config file.
+* @return Number of generations kept, the last ones of the simulation.
+*/
+size_t Config::set_stats_capacity(IniParser &filename) {
+    int capacity;
+    bool informed = filename.get_int("Stats", "capacity", capacity);  //!<- Show if the data was provided.
+
+    /// Check if input was be informed.
+    if (!informed || capacity == 0) {
+        capacity = 100000;
+    }
+
+    if (capacity < 0) {
+        throw std::invalid_argument("Used a negative value in < capacity > when a positive integer was expected.");
+    }
+
+    return static_cast<size_t>(capacity);
+}
+
 /*!
 * This function use others functions to set all members class.
 * @param filename Name of the config file.
@@ -220,6 +976,9 @@ void Config::load(const std::string &filename) {
 	// Set the global configuration.
 	input_cfg = set_input_cfg(reader);
 	max_gen = set_max_gen(reader);
+	rows = set_rows(reader);
+	cols = set_cols(reader);
+	output_cfg = set_output_cfg(reader);
 
 	// Set image configurations.
 	generate_image = set_generate_image(reader);
@@ -227,9 +986,52 @@ void Config::load(const std::string &filename) {
 	bkg_color = set_bkg_color(reader);
 	block_size = set_block_size(reader);
 	path = set_path(reader);
+	encoders = set_encoders(reader);
+	queue_size = set_queue_size(reader);
+	output = set_output(reader);
+	apng_file = set_apng_file(reader);
+	raw_target = set_raw_target(reader);
+	color_mode = set_color_mode(reader);
+	deflate_window = set_deflate_window(reader);
+	deflate_nicematch = set_deflate_nicematch(reader);
+	deflate_lazy = set_deflate_lazy(reader);
 
 	// Set text configuration.
 	fps = set_fps(reader);
+	text_mode = set_text_mode(reader);
+	drop_frames = set_drop_frames(reader);
+	glyph = set_glyph(reader);
+	zoom = set_zoom(reader);
+	view_row = set_view(reader, "view_row");
+	view_col = set_view(reader, "view_col");
+	view_rows = set_view(reader, "view_rows");
+	view_cols = set_view(reader, "view_cols");
+
+	// Set simulation configuration.
+	engine = set_engine(reader);
+	threads = set_threads(reader);
+	jump_to = set_jump_to(reader);
+	node_cache = set_node_cache(reader);
+	kernel = set_kernel(reader);
+	topology = set_topology(reader);
+	rule = set_rule(reader);
+	checkpoint_every = set_checkpoint_every(reader);
+	checkpoint_file = set_checkpoint_file(reader);
+
+	// Set history configuration.
+	history_keyframe = set_history_keyframe(reader);
+	history_memory = set_history_memory(reader);
+	history_dump = set_history_dump(reader);
+	history_dump_all = set_history_dump_all(reader);
+
+	// Set batch configuration.
+	batch_workers = set_batch_workers(reader);
+	batch_summary = set_batch_summary(reader);
+	curve_points = set_curve_points(reader);
+
+	// Set statistics configuration.
+	stats_file = set_stats_file(reader);
+	stats_capacity = set_stats_capacity(reader);
 
     std::cout << ">>> File [ " << filename << " ] read successfully!" << std::endl;
 }
\ No newline at end of file
@@ -20,6 +20,12 @@ public:
 	std::string set_input_cfg(IniParser &filename);
 	/// Set number of max_gen.
 	size_t set_max_gen(IniParser &filename);
+	/// Set number of rows of the board.
+	size_t set_rows(IniParser &filename);
+	/// Set number of columns of the board.
+	size_t set_cols(IniParser &filename);
+	/// Set file that receives the last generation.
+	std::string set_output_cfg(IniParser &filename);
 	/// Set bool of genetare_image.
 	bool set_generate_image(IniParser &filename);
 	/// Set color of alive cells.
@@ -30,8 +36,72 @@ public:
 	size_t set_block_size(IniParser &filename);
 	/// Set path.
 	std::string set_path(IniParser &filename);
+	/// Set number of encoder threads.
+	size_t set_encoders(IniParser &filename);
+	/// Set size of the image queue.
+	size_t set_queue_size(IniParser &filename);
+	/// Set kind of image output.
+	std::string set_output(IniParser &filename);
+	/// Set name of the animation file.
+	std::string set_apng_file(IniParser &filename);
+	/// Set destination of the raw frames.
+	std::string set_raw_target(IniParser &filename);
+	/// Set color mode of the PNG images.
+	std::string set_color_mode(IniParser &filename);
+	/// Set deflate window size.
+	unsigned set_deflate_window(IniParser &filename);
+	/// Set deflate match length that stops the search.
+	unsigned set_deflate_nicematch(IniParser &filename);
+	/// Set bool of deflate lazy matching.
+	bool set_deflate_lazy(IniParser &filename);
 	/// Set fps.
 	int set_fps(IniParser &filename);
+	/// Set text mode.
+	std::string set_text_mode(IniParser &filename);
+	/// Set bool of drop_frames.
+	bool set_drop_frames(IniParser &filename);
+	/// Set text glyph.
+	std::string set_glyph(IniParser &filename);
+	/// Set text zoom.
+	size_t set_zoom(IniParser &filename);
+	/// Set a coordinate or size of the text viewport.
+	size_t set_view(IniParser &filename, const std::string &key);
+	/// Set engine.
+	std::string set_engine(IniParser &filename);
+	/// Set number of threads.
+	size_t set_threads(IniParser &filename);
+	/// Set first generation shown.
+	size_t set_jump_to(IniParser &filename);
+	/// Set node cache size of HashLife.
+	size_t set_node_cache(IniParser &filename);
+	/// Set vector kernel.
+	std::string set_kernel(IniParser &filename);
+	/// Set board topology.
+	std::string set_topology(IniParser &filename);
+	/// Set rule of the simulation.
+	std::string set_rule(IniParser &filename);
+	/// Set checkpoint interval.
+	size_t set_checkpoint_every(IniParser &filename);
+	/// Set checkpoint file.
+	std::string set_checkpoint_file(IniParser &filename);
+	/// Set history keyframe interval.
+	size_t set_history_keyframe(IniParser &filename);
+	/// Set history memory cap.
+	size_t set_history_memory(IniParser &filename);
+	/// Set history dump directory.
+	std::string set_history_dump(IniParser &filename);
+	/// Set bool of history dump_all.
+	bool set_history_dump_all(IniParser &filename);
+	/// Set number of batch workers.
+	size_t set_batch_workers(IniParser &filename);
+	/// Set batch summary file.
+	std::string set_batch_summary(IniParser &filename);
+	/// Set number of points of the population curves.
+	size_t set_curve_points(IniParser &filename);
+	/// Set statistics file.
+	std::string set_stats_file(IniParser &filename);
+	/// Set statistics capacity.
+	size_t set_stats_capacity(IniParser &filename);
 	/// Set all members with others methods.
 	void load(const std::string &filename);
 
@@ -40,6 +110,12 @@ public:
 	std::string get_input_cfg() { return input_cfg; }
 	/// Get number of max_gen.
 	size_t get_max_gen() { return max_gen; }
+	/// Get number of rows of the board.
+	size_t get_rows() { return rows; }
+	/// Get number of columns of the board.
+	size_t get_cols() { return cols; }
+	/// Get file that receives the last generation.
+	std::string get_output_cfg() { return output_cfg; }
 	/// Get bool of genetare_image.
 	bool get_generate_image() { return generate_image; }
 	/// Get color of alive cells.
@@ -50,8 +126,78 @@ public:
 	size_t get_block_size() { return block_size; }
 	/// Get path.
 	std::string get_path() { return path; }
+	/// Get number of encoder threads.
+	size_t get_encoders() { return encoders; }
+	/// Get size of the image queue.
+	size_t get_queue_size() { return queue_size; }
+	/// Get kind of image output.
+	std::string get_output() { return output; }
+	/// Get name of the animation file.
+	std::string get_apng_file() { return apng_file; }
+	/// Get destination of the raw frames.
+	std::string get_raw_target() { return raw_target; }
+	/// Get color mode of the PNG images.
+	std::string get_color_mode() { return color_mode; }
+	/// Get deflate window size.
+	unsigned get_deflate_window() { return deflate_window; }
+	/// Get deflate match length that stops the search.
+	unsigned get_deflate_nicematch() { return deflate_nicematch; }
+	/// Get bool of deflate lazy matching.
+	bool get_deflate_lazy() { return deflate_lazy; }
 	/// Get fps.
 	int get_fps() { return fps; }
+	/// Get text mode.
+	std::string get_text_mode() { return text_mode; }
+	/// Get bool of drop_frames.
+	bool get_drop_frames() { return drop_frames; }
+	/// Get text glyph.
+	std::string get_glyph() { return glyph; }
+	/// Get text zoom.
+	size_t get_zoom() { return zoom; }
+	/// Get first row of the text viewport.
+	size_t get_view_row() { return view_row; }
+	/// Get first column of the text viewport.
+	size_t get_view_col() { return view_col; }
+	/// Get number of rows of the text viewport.
+	size_t get_view_rows() { return view_rows; }
+	/// Get number of columns of the text viewport.
+	size_t get_view_cols() { return view_cols; }
+	/// Get engine.
+	std::string get_engine() { return engine; }
+	/// Get number of threads.
+	size_t get_threads() { return threads; }
+	/// Get first generation shown.
+	size_t get_jump_to() { return jump_to; }
+	/// Get node cache size of HashLife.
+	size_t get_node_cache() { return node_cache; }
+	/// Get vector kernel.
+	std::string get_kernel() { return kernel; }
+	/// Get board topology.
+	std::string get_topology() { return topology; }
+	/// Get rule of the simulation, empty for the rule of the pattern.
+	std::string get_rule() { return rule; }
+	/// Get checkpoint interval.
+	size_t get_checkpoint_every() { return checkpoint_every; }
+	/// Get checkpoint file.
+	std::string get_checkpoint_file() { return checkpoint_file; }
+	/// Get history keyframe interval.
+	size_t get_history_keyframe() { return history_keyframe; }
+	/// Get history memory cap, in MiB.
+	size_t get_history_memory() { return history_memory; }
+	/// Get history dump directory.
+	std::string get_history_dump() { return history_dump; }
+	/// Get bool of history dump_all.
+	bool get_history_dump_all() { return history_dump_all; }
+	/// Get number of batch workers.
+	size_t get_batch_workers() { return batch_workers; }
+	/// Get batch summary file.
+	std::string get_batch_summary() { return batch_summary; }
+	/// Get number of points of the population curves.
+	size_t get_curve_points() { return curve_points; }
+	/// Get statistics file.
+	std::string get_stats_file() { return stats_file; }
+	/// Get statistics capacity.
+	size_t get_stats_capacity() { return stats_capacity; }
 	
 	//=== Auxiliary functions.
 	/// Remove quotes of the paths.
@@ -60,12 +206,50 @@ public:
 private:
 	std::string input_cfg;   //!< The file where the simulation grid configuration is located.
 	size_t max_gen;          //!< Maximum number of generations for the simulation.
+	size_t rows;             //!< Rows of the board for RLE and plaintext patterns, zero for the pattern size.
+	size_t cols;             //!< Columns of the board for RLE and plaintext patterns, zero for the pattern size.
+	std::string output_cfg;  //!< The file where the last generation is saved, empty for none.
 	bool generate_image;     //!< Boolean indicating whether simulation images will be generated.
 	Color alive_color;       //!< Color of alive cell in image.
 	Color bkg_color;         //!< Color of background in image.
 	size_t block_size;       //!< Pixel size of each cell.
 	std::string path;        //!< The directory where the images will be saved.
+	size_t encoders;         //!< Number of threads that encode the images.
+	size_t queue_size;       //!< Maximum number of images waiting to be encoded.
+	std::string output;      //!< Kind of image output: one PNG per generation, an animation or raw frames.
+	std::string apng_file;   //!< Name of the animation file, inside path.
+	std::string raw_target;  //!< File or FIFO that receives the raw frames, "-" for the standard output.
+	std::string color_mode;  //!< PNG pixels: 1-bit palette or RGBA.
+	unsigned deflate_window;     //!< LZ77 window size of the PNG compression.
+	unsigned deflate_nicematch;  //!< Match length that stops the search of the PNG compression.
+	bool deflate_lazy;       //!< Boolean indicating whether the PNG compression uses lazy matching.
 	int fps;                 //!< Display output speed
+	std::string text_mode;   //!< How the generations are shown: scroll, ansi or diff.
+	bool drop_frames;        //!< Boolean indicating whether late frames of the text output are skipped.
+	std::string glyph;       //!< Glyphs of the text output: bullet, half or braille.
+	size_t zoom;             //!< Cells of each side of a glyph dot, the dot being alive if any of them is.
+	size_t view_row;         //!< First row of the board shown in text mode.
+	size_t view_col;         //!< First column of the board shown in text mode.
+	size_t view_rows;        //!< Rows of the board shown in text mode, zero to fit the terminal.
+	size_t view_cols;        //!< Columns of the board shown in text mode, zero to fit the terminal.
+	std::string engine;      //!< Board representation used to compute the generations.
+	size_t threads;          //!< Number of threads that compute each generation.
+	size_t jump_to;          //!< First generation shown, the previous ones are skipped.
+	size_t node_cache;       //!< Maximum number of nodes kept by the HashLife engine.
+	std::string kernel;      //!< Vector instruction set used by the simd engine.
+	std::string topology;    //!< What lies beyond the edges of the board.
+	std::string rule;        //!< Rule of the simulation in B/S notation, empty for the rule of the pattern.
+	size_t checkpoint_every; //!< Generations between checkpoints, zero for none.
+	std::string checkpoint_file;  //!< The file where the checkpoints are saved.
+	size_t history_keyframe; //!< Generations between two whole boards of the history.
+	size_t history_memory;   //!< Maximum MiB of the history of boards, zero for no limit.
+	std::string history_dump;  //!< The directory that receives past generations when stability is found, empty for none.
+	bool history_dump_all;   //!< Boolean indicating whether every kept generation is dumped, or only the cycle.
+	size_t batch_workers;    //!< Number of simulations of a batch run at once.
+	std::string batch_summary;  //!< The CSV file that receives the summary of a batch.
+	size_t curve_points;     //!< Maximum number of populations in each curve of the summary, zero for all.
+	std::string stats_file;  //!< The CSV or JSON file that receives the statistics of each generation, empty for none.
+	size_t stats_capacity;   //!< Maximum number of generations kept in the statistics.
 };
 
 #endif // CONFIG_H
\ No newline at end of file
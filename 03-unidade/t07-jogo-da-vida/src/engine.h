@@ -0,0 +1,127 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "rule.h"
+
+namespace life {
+
+class LifeCfg;
+class ThreadPool;
+
+/// What lies beyond the edges of the board.
+enum class e_topology : short {
+  BOUNDED = 0,  //!< Dead cells: patterns die at the edges.
+  TORUS,        //!< The opposite edge: patterns wrap around.
+  PLANE,        //!< More cells: the board is a window on an unbounded plane.
+};
+
+/*!
+ * Copies the opposite edges of a byte-per-cell board into its ghost border,
+ * so the neighbors read across an edge are the ones of a torus.
+ * @param cells The board, `(rows + 2) * (cols + 2)` cells.
+ * @param rows Number of rows, without the ghost border.
+ * @param cols Number of columns, without the ghost border.
+ */
+inline void wrap_border(uint8_t* cells, size_t rows, size_t cols) {
+  const size_t stride = cols + 2;
+  for (size_t r = 1; r <= rows; ++r) {
+    cells[r * stride] = cells[r * stride + cols];
+    cells[r * stride + cols + 1] = cells[r * stride + 1];
+  }
+  /// Whole rows, after the columns, so the corners are wrapped too.
+  std::copy(cells + rows * stride, cells + (rows + 1) * stride, cells);
+  std::copy(cells + stride, cells + 2 * stride, cells + (rows + 1) * stride);
+}
+
+/*!
+ * Kills the cells of the ghost border of a byte-per-cell board.
+ * @param cells The board, `(rows + 2) * (cols + 2)` cells.
+ * @param rows Number of rows, without the ghost border.
+ * @param cols Number of columns, without the ghost border.
+ */
+inline void clear_border(uint8_t* cells, size_t rows, size_t cols) {
+  const size_t stride = cols + 2;
+  std::fill(cells, cells + stride, 0);
+  std::fill(cells + (rows + 1) * stride, cells + (rows + 2) * stride, 0);
+  for (size_t r = 1; r <= rows; ++r) {
+    cells[r * stride] = 0;
+    cells[r * stride + cols + 1] = 0;
+  }
+}
+
+/*!
+ * Interface of an alternative stepping engine for a life board.
+ *
+ * An engine keeps the board in its own representation, advances it one
+ * generation at a time and writes the result back into the cells of a
+ * `LifeCfg`, so every other part of the simulation (stability, output)
+ * keeps working on the regular board. An engine may write back only what
+ * changed since the previous `store()`, and writes cells through
+ * `LifeCfg::set_alive()`, which records the cells that flip.
+ */
+class Engine {
+public:
+  //=== Special members
+  /// Virtual destructor
+  virtual ~Engine() = default;
+
+  //=== Members
+  /// Copies the current state of a board into the engine's representation.
+  virtual void load(const LifeCfg& cfg) = 0;
+  /// Advances the engine's representation to the next generation.
+  virtual void step() = 0;
+  /// Advances the engine's representation by a number of generations.
+  virtual void advance(uint64_t generations) {
+    for (; generations > 0; --generations) { step(); }
+  }
+  /// Writes the engine's current generation back into the board cells.
+  virtual void store(LifeCfg& cfg) = 0;
+  /// Number of alive cells in the current generation.
+  [[nodiscard]] virtual size_t population() const = 0;
+  /// Sets the pool used to step row bands in parallel, null to step serially.
+  void set_thread_pool(ThreadPool* pool) { m_pool = pool; }
+  /// Selects the topology used by the next load, returning false if it is not supported.
+  virtual bool set_topology(e_topology topology) {
+    m_topology = topology;
+    return topology != e_topology::PLANE;
+  }
+
+  /// Describes the whole plane for the stability detector, returning false if the board window is the whole board.
+  virtual bool plane_key(std::vector<uint64_t>& key) const {
+    (void)key;
+    return false;
+  }
+  /// Tells whether the plane keys describe the cells themselves, so keys of another run can be compared with them.
+  [[nodiscard]] virtual bool portable_plane_key() const { return false; }
+  /// Writes the live cells of the whole plane, returning false if the board window is the whole board.
+  virtual bool save_plane(std::vector<uint64_t>& plane) const {
+    (void)plane;
+    return false;
+  }
+  /// Replaces the board with the live cells of a plane written by save_plane(), returning false if the engine has no plane.
+  virtual bool load_plane(const LifeCfg& cfg, const std::vector<uint64_t>& plane) {
+    (void)cfg;
+    (void)plane;
+    return false;
+  }
+
+  /// Selects the rule of the next steps, returning false if it is not supported.
+  virtual bool set_rule(const Rule& rule) {
+    m_rule = rule;
+    return true;
+  }
+
+protected:
+  ThreadPool* m_pool{ nullptr };  //!< Pool shared with the owning board, may be null.
+  e_topology m_topology{ e_topology::BOUNDED };  //!< What lies beyond the edges of the board.
+  Rule m_rule;                    //!< Rule of the simulation, B3/S23 by default.
+};
+
+}  // namespace life
+
+#endif  // ENGINE_H
@@ -0,0 +1,23 @@
+#ifndef FRAME_H
+#define FRAME_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace life {
+
+/// Compact copy of a board, one bit per cell, handed to the image encoders.
+struct Frame {
+  size_t sequence{ 0 };          //!< Order in which the frame was pushed.
+  int generation{ 0 };           //!< Generation of the board.
+  size_t rows{ 0 };              //!< Number of rows of the board.
+  size_t cols{ 0 };              //!< Number of columns of the board.
+  std::vector<uint64_t> bits;    //!< Cells in row-major order, 64 per word.
+  bool has_changes{ false };     //!< Whether `changed` covers every cell that differs from the previous frame.
+  std::vector<size_t> changed;   //!< Row-major indices of the cells that may differ from the previous frame.
+};
+
+}  // namespace life
+
+#endif  // FRAME_H
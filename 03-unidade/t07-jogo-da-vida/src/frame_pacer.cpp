@@ -0,0 +1,67 @@
+/*!
+ * FramePacer class implementation.
+ * @file frame_pacer.cpp
+ */
+
+#include "frame_pacer.h"
+
+#include <thread>
+
+namespace life {
+
+/*!
+ * Starts the schedule, with the first frame due at once.
+ * @param fps Target frame rate, at least one.
+ * @param drop_frames Whether frames more than one period late are dropped.
+ */
+FramePacer::FramePacer(int fps, bool drop_frames)
+    : m_fps(fps),
+      m_period(std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / fps))),
+      m_drop_frames(drop_frames),
+      m_start(clock::now()),
+      m_deadline(m_start),
+      m_last_drawn(m_start) {}
+
+/*!
+ * Tells whether the current frame should be drawn. A frame is dropped only
+ * when dropping is enabled, it is more than one period late and a frame was
+ * drawn less than a second ago.
+ * @return true if the frame should be drawn, false if it is dropped.
+ */
+bool FramePacer::begin_frame() {
+  const clock::time_point now = clock::now();
+  if (m_drop_frames && now > m_deadline + m_period && now - m_last_drawn < std::chrono::seconds(1)) {
+    ++m_dropped;
+    return false;
+  }
+  ++m_drawn;
+  m_last_drawn = now;
+  return true;
+}
+
+/*!
+ * Waits until the next frame is due. The deadlines are not moved when the
+ * frames run late, so the lost time is recovered by dropping frames (if
+ * enabled) or by not waiting until the schedule is met again; only a delay
+ * longer than a second is given up, restarting the schedule from now.
+ */
+void FramePacer::end_frame() {
+  m_deadline += m_period;
+  const clock::time_point now = clock::now();
+  if (now - m_deadline > std::chrono::seconds(1)) {
+    m_deadline = now;
+    return;
+  }
+  std::this_thread::sleep_until(m_deadline);
+}
+
+/*!
+ * Frames drawn per second, from the first frame to the last one drawn.
+ * @return The achieved frame rate, zero before two frames are drawn.
+ */
+double FramePacer::achieved_fps() const {
+  const double seconds = std::chrono::duration<double>(m_last_drawn - m_start).count();
+  return m_drawn > 1 && seconds > 0 ? static_cast<double>(m_drawn - 1) / seconds : 0.0;
+}
+
+}  // namespace life
@@ -0,0 +1,55 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <chrono>
+#include <cstddef>
+
+namespace life {
+
+/*!
+ * Paces the frames of the text output at a target rate.
+ *
+ * Frame k is due at start + k * period on the steady clock, so the time
+ * spent stepping and printing is taken from the wait instead of added to
+ * it, and the rate does not drift. When dropping is enabled, a frame more
+ * than one period late is not drawn (the simulation goes on) until the
+ * schedule is met again, though one frame per second is always drawn.
+ */
+class FramePacer {
+public:
+  using clock = std::chrono::steady_clock;
+
+  //=== Special members
+  /// Constructor, the first frame is due at once.
+  FramePacer(int fps, bool drop_frames);
+
+  //=== Members
+  /// Tells whether the current frame should be drawn, counting it as drawn or dropped.
+  bool begin_frame();
+  /// Waits until the next frame is due.
+  void end_frame();
+
+  //=== Attribute accessors members.
+  /// Number of frames drawn.
+  [[nodiscard]] size_t drawn() const { return m_drawn; }
+  /// Number of frames dropped.
+  [[nodiscard]] size_t dropped() const { return m_dropped; }
+  /// Target frame rate.
+  [[nodiscard]] int target_fps() const { return m_fps; }
+  /// Frames drawn per second since the first frame.
+  [[nodiscard]] double achieved_fps() const;
+
+private:
+  int m_fps;                       //!< Target frame rate.
+  clock::duration m_period;        //!< Time between two frames.
+  bool m_drop_frames;              //!< Whether late frames are dropped.
+  clock::time_point m_start;       //!< When the first frame was due.
+  clock::time_point m_deadline;    //!< When the current frame is due.
+  clock::time_point m_last_drawn;  //!< When the last frame was drawn.
+  size_t m_drawn{ 0 };             //!< Number of frames drawn.
+  size_t m_dropped{ 0 };           //!< Number of frames dropped.
+};
+
+}  // namespace life
+
+#endif  // FRAME_PACER_H
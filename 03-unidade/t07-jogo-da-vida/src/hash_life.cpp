@@ -0,0 +1,522 @@
+/*!
+ * HashLife class implementation.
+ * @file hash_life.cpp
+ */
+
+#include "hash_life.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "life.h"
+
+namespace life {
+
+/*!
+ * Hash of a node key, mixing the addresses of the four quadrants.
+ * @param key The quadrants of a node.
+ * @return The hash of the key.
+ */
+size_t HashLife::KeyHash::operator()(const key_t& key) const {
+  uint64_t hash = 0;
+  for (const Node* quadrant : key) {
+    hash = (hash ^ reinterpret_cast<uintptr_t>(quadrant)) * 0x9E3779B97F4A7C15ULL;
+    hash ^= hash >> 29;
+  }
+  return static_cast<size_t>(hash);
+}
+
+/*!
+ * Constructor, starts with an empty plane.
+ * @param node_limit How many nodes may be stored before unused ones are discarded.
+ */
+HashLife::HashLife(size_t node_limit) : m_node_limit(node_limit) {
+  m_dead = make_leaf(false);
+  m_alive = make_leaf(true);
+  m_root = empty(3);
+}
+
+/*!
+ * Creates a node holding a single cell.
+ * @param alive Whether the cell is alive.
+ * @return The new leaf.
+ */
+HashLife::Node* HashLife::make_leaf(bool alive) {
+  m_nodes.push_back(Node{ nullptr, nullptr, nullptr, nullptr, alive ? 1U : 0U, 0, nullptr, -1 });
+  return &m_nodes.back();
+}
+
+/*!
+ * Returns the canonical node with the given quadrants, creating it if needed.
+ * @param nw North-west quadrant.
+ * @param ne North-east quadrant.
+ * @param sw South-west quadrant.
+ * @param se South-east quadrant.
+ * @return The node made of the four quadrants.
+ */
+HashLife::Node* HashLife::join(Node* nw, Node* ne, Node* sw, Node* se) {
+  const key_t key{ nw, ne, sw, se };
+  auto it = m_table.find(key);
+  if (it != m_table.end()) { return it->second; }
+
+  const uint64_t population = nw->population + ne->population + sw->population + se->population;
+  m_nodes.push_back(Node{ nw, ne, sw, se, population, nw->level + 1, nullptr, -1 });
+  m_table.emplace(key, &m_nodes.back());
+  return &m_nodes.back();
+}
+
+/*!
+ * Returns the canonical empty node of a level.
+ * @param level Log2 of the node side.
+ * @return The empty node.
+ */
+HashLife::Node* HashLife::empty(unsigned level) {
+  if (m_empty.empty()) { m_empty.push_back(m_dead); }
+  while (m_empty.size() <= level) {
+    Node* last = m_empty.back();
+    m_empty.push_back(join(last, last, last, last));
+  }
+  return m_empty[level];
+}
+
+/*!
+ * Builds the node of a level whose top-left cell is (row, col) of a board.
+ * @param cfg The board.
+ * @param level Log2 of the node side.
+ * @param row Board row of the top-left cell of the node.
+ * @param col Board column of the top-left cell of the node.
+ * @return The node with the cells of the board in that region.
+ */
+HashLife::Node* HashLife::build(const LifeCfg& cfg, unsigned level, size_t row, size_t col) {
+  if (row > m_rows || col > m_cols) { return empty(level); }
+  if (level == 0) { return cfg.get_cell(row, col).is_alive ? m_alive : m_dead; }
+
+  const size_t half = size_t{ 1 } << (level - 1);
+  return join(build(cfg, level - 1, row, col),
+              build(cfg, level - 1, row, col + half),
+              build(cfg, level - 1, row + half, col),
+              build(cfg, level - 1, row + half, col + half));
+}
+
+/*!
+ * Accepts the plane, which is always simulated, and the default bounded
+ * topology (which keeps meaning a plane here); a torus is not supported.
+ * @param topology What lies beyond the edges of the board.
+ * @return false for a torus, true otherwise.
+ */
+bool HashLife::set_topology(e_topology topology) {
+  m_topology = e_topology::PLANE;
+  return topology != e_topology::TORUS;
+}
+
+/*!
+ * Selects the rule of the next steps. A rule that gives birth to cells with
+ * no alive neighbors (B0) would fill the whole plane, so it is not supported.
+ * @param rule The rule of the simulation.
+ * @return false for a B0 rule, true otherwise.
+ */
+bool HashLife::set_rule(const Rule& rule) {
+  if (rule.born(0)) { return false; }
+  m_rule = rule;
+  m_states = make_state_table(rule.birth, rule.survival);
+  return true;
+}
+
+/*!
+ * Describes the plane for the stability detector. Nodes are canonical, so
+ * the same contents are always the same node, and the root is kept at the
+ * smallest level around a fixed center (see shrink()): the key is the
+ * address of the root, with its level and the board coordinates of its
+ * top-left cell. Addresses are only compared between keys of the same
+ * storage, so the key also carries the number of collections.
+ * @param key Receives the key.
+ * @return true, HashLife always simulates a plane.
+ */
+bool HashLife::plane_key(std::vector<uint64_t>& key) const {
+  key.assign({ m_collections, m_root->level, static_cast<uint64_t>(m_origin_row), static_cast<uint64_t>(m_origin_col),
+               static_cast<uint64_t>(reinterpret_cast<uintptr_t>(m_root)) });
+  return true;
+}
+
+/*!
+ * Builds the quadtree with the alive cells of a board.
+ * @param cfg The board to be copied.
+ */
+void HashLife::load(const LifeCfg& cfg) {
+  m_rows = cfg.m_rows;
+  m_cols = cfg.m_cols;
+  m_origin_row = 1;
+  m_origin_col = 1;
+  m_window.assign(m_rows * m_cols, 0);
+
+  unsigned level = 3;
+  while ((size_t{ 1 } << level) < std::max(m_rows, m_cols)) { ++level; }
+  m_root = build(cfg, level, 1, 1);
+  shrink();
+}
+
+/*!
+ * Builds the node of a level whose top-left cell is (row, col) of a plane
+ * written by save_plane(); regions outside its box are empty.
+ * @param plane The live cells of the plane.
+ * @param level Log2 of the node side.
+ * @param row Board row of the top-left cell of the node.
+ * @param col Board column of the top-left cell of the node.
+ * @return The node with the cells of the plane in that region.
+ */
+HashLife::Node* HashLife::build(const std::vector<uint64_t>& plane, unsigned level, int64_t row, int64_t col) {
+  const int64_t top = static_cast<int64_t>(plane[0]);
+  const int64_t left = static_cast<int64_t>(plane[1]);
+  const int64_t height = static_cast<int64_t>(plane[2]);
+  const int64_t width = static_cast<int64_t>(plane[3]);
+  const int64_t side = int64_t{ 1 } << level;
+  if (row >= top + height || col >= left + width || row + side <= top || col + side <= left) { return empty(level); }
+  if (level == 0) {
+    const size_t bit = static_cast<size_t>((row - top) * width + (col - left));
+    return (plane[4 + bit / 64] >> (bit % 64)) & 1U ? m_alive : m_dead;
+  }
+
+  const int64_t half = side / 2;
+  return join(build(plane, level - 1, row, col),
+              build(plane, level - 1, row, col + half),
+              build(plane, level - 1, row + half, col),
+              build(plane, level - 1, row + half, col + half));
+}
+
+/*!
+ * Finds the bounding box of the live cells of a node, widening a box.
+ * @param node The node.
+ * @param row Board row of the top-left cell of the node.
+ * @param col Board column of the top-left cell of the node.
+ * @param box First row, first column, last row and last column of the box.
+ */
+void HashLife::bounds(const Node* node, int64_t row, int64_t col, int64_t box[4]) const {
+  if (node->population == 0) { return; }
+  if (node->level == 0) {
+    box[0] = std::min(box[0], row);
+    box[1] = std::min(box[1], col);
+    box[2] = std::max(box[2], row);
+    box[3] = std::max(box[3], col);
+    return;
+  }
+
+  const int64_t half = int64_t{ 1 } << (node->level - 1);
+  bounds(node->nw, row, col, box);
+  bounds(node->ne, row, col + half, box);
+  bounds(node->sw, row + half, col, box);
+  bounds(node->se, row + half, col + half, box);
+}
+
+/*!
+ * Sets the bits of the live cells of a node in a plane box, whose first
+ * four words (position and size) are already written.
+ * @param node The node.
+ * @param row Board row of the top-left cell of the node.
+ * @param col Board column of the top-left cell of the node.
+ * @param plane The plane box.
+ */
+void HashLife::pack(const Node* node, int64_t row, int64_t col, std::vector<uint64_t>& plane) const {
+  if (node->population == 0) { return; }
+  if (node->level == 0) {
+    const int64_t width = static_cast<int64_t>(plane[3]);
+    const size_t bit = static_cast<size_t>((row - static_cast<int64_t>(plane[0])) * width
+                                           + (col - static_cast<int64_t>(plane[1])));
+    plane[4 + bit / 64] |= uint64_t{ 1 } << (bit % 64);
+    return;
+  }
+
+  const int64_t half = int64_t{ 1 } << (node->level - 1);
+  pack(node->nw, row, col, plane);
+  pack(node->ne, row, col + half, plane);
+  pack(node->sw, row + half, col, plane);
+  pack(node->se, row + half, col + half, plane);
+}
+
+/*!
+ * Writes the live cells of the plane, in the layout of BitBoard::plane_key():
+ * the board row and column of the top-left cell of their bounding box, its
+ * height and width, and its cells bit-packed in row-major order.
+ * @param plane Receives the live cells.
+ * @return true, HashLife always simulates a plane.
+ */
+bool HashLife::save_plane(std::vector<uint64_t>& plane) const {
+  int64_t box[4] = { INT64_MAX, INT64_MAX, INT64_MIN, INT64_MIN };
+  bounds(m_root, m_origin_row, m_origin_col, box);
+
+  plane.assign(4, 0);
+  if (m_root->population == 0) { return true; }
+
+  const uint64_t height = static_cast<uint64_t>(box[2] - box[0] + 1);
+  const uint64_t width = static_cast<uint64_t>(box[3] - box[1] + 1);
+  plane = { static_cast<uint64_t>(box[0]), static_cast<uint64_t>(box[1]), height, width };
+  plane.resize(4 + (height * width + 63) / 64, 0);
+  pack(m_root, m_origin_row, m_origin_col, plane);
+  return true;
+}
+
+/*!
+ * Builds the quadtree with the live cells of a plane written by
+ * save_plane(). The root covers the window of the board and the box.
+ * @param cfg The board whose window is shown.
+ * @param plane The live cells of the plane.
+ * @return true, unless the plane is incomplete.
+ */
+bool HashLife::load_plane(const LifeCfg& cfg, const std::vector<uint64_t>& plane) {
+  if (plane.size() < 4 || plane.size() < 4 + (plane[2] * plane[3] + 63) / 64) { return false; }
+
+  m_rows = cfg.m_rows;
+  m_cols = cfg.m_cols;
+  m_window.assign(m_rows * m_cols, 0);
+
+  const int64_t top = static_cast<int64_t>(plane[0]);
+  const int64_t left = static_cast<int64_t>(plane[1]);
+  const bool empty_plane = plane[2] == 0 || plane[3] == 0;
+  m_origin_row = empty_plane ? 1 : std::min<int64_t>(1, top);
+  m_origin_col = empty_plane ? 1 : std::min<int64_t>(1, left);
+  const int64_t last_row = empty_plane ? static_cast<int64_t>(m_rows)
+                                       : std::max(static_cast<int64_t>(m_rows), top + static_cast<int64_t>(plane[2]) - 1);
+  const int64_t last_col = empty_plane ? static_cast<int64_t>(m_cols)
+                                       : std::max(static_cast<int64_t>(m_cols), left + static_cast<int64_t>(plane[3]) - 1);
+
+  unsigned level = 3;
+  while ((int64_t{ 1 } << level) < std::max(last_row - m_origin_row + 1, last_col - m_origin_col + 1)) { ++level; }
+  m_root = build(plane, level, m_origin_row, m_origin_col);
+  shrink();
+  return true;
+}
+
+/*!
+ * Returns the center of a node, with half of its side.
+ * @param node A node of level 2 or more.
+ * @return The center of the node.
+ */
+HashLife::Node* HashLife::center(Node* node) {
+  return join(node->nw->se, node->ne->sw, node->sw->ne, node->se->nw);
+}
+
+/*!
+ * Surrounds the root with empty space, doubling its side and keeping it centered.
+ */
+void HashLife::expand() {
+  Node* border = empty(m_root->level - 1);
+  const int64_t shift = int64_t{ 1 } << (m_root->level - 1);
+
+  m_root = join(join(border, border, border, m_root->nw),
+                join(border, border, m_root->ne, border),
+                join(border, m_root->sw, border, border),
+                join(m_root->se, border, border, border));
+  m_origin_row -= shift;
+  m_origin_col -= shift;
+}
+
+/*!
+ * Replaces the root by its center while the center holds every live cell.
+ * Expanding, advancing and shrinking all keep the center of the root in the
+ * same place of the plane, so after shrinking the root (and its level) only
+ * depends on the live cells: the same plane always has the same root.
+ */
+void HashLife::shrink() {
+  while (m_root->level > 3
+         && m_root->nw->se->population + m_root->ne->sw->population + m_root->sw->ne->population
+                    + m_root->se->nw->population
+                == m_root->population) {
+    const int64_t shift = int64_t{ 1 } << (m_root->level - 2);
+    m_root = center(m_root);
+    m_origin_row += shift;
+    m_origin_col += shift;
+  }
+}
+
+/*!
+ * Computes the center of a level 2 node (4x4 cells) one generation ahead.
+ * @param node A level 2 node.
+ * @return The level 1 node with the next state of the four center cells.
+ */
+HashLife::Node* HashLife::step_square(Node* node) {
+  bool cells[4][4];
+  for (size_t y = 0; y < 4; ++y) {
+    for (size_t x = 0; x < 4; ++x) {
+      const Node* quadrant = y < 2 ? (x < 2 ? node->nw : node->ne) : (x < 2 ? node->sw : node->se);
+      const Node* leaf = y % 2 == 0 ? (x % 2 == 0 ? quadrant->nw : quadrant->ne)
+                                    : (x % 2 == 0 ? quadrant->sw : quadrant->se);
+      cells[y][x] = leaf->population != 0;
+    }
+  }
+
+  Node* next[2][2];
+  for (size_t y = 1; y <= 2; ++y) {
+    for (size_t x = 1; x <= 2; ++x) {
+      size_t alive_neighbors = 0;
+      for (size_t i = y - 1; i <= y + 1; ++i) {
+        for (size_t j = x - 1; j <= x + 1; ++j) {
+          if ((i != y || j != x) && cells[i][j]) { ++alive_neighbors; }
+        }
+      }
+      const bool alive = m_states.next[cells[y][x]][alive_neighbors] != 0;
+      next[y - 1][x - 1] = alive ? m_alive : m_dead;
+    }
+  }
+  return join(next[0][0], next[0][1], next[1][0], next[1][1]);
+}
+
+/*!
+ * Computes the center of a node 2^step generations ahead.
+ *
+ * The node is covered by nine overlapping squares of half its side. When
+ * the step is the largest one the node allows (level - 2), each square is
+ * advanced half of the way, and the four squares made of their results are
+ * advanced the rest; for smaller steps, the squares are just centered and
+ * the four combined squares are advanced the whole step.
+ * @param node A node of level 2 or more.
+ * @param step Log2 of the generations, at most the node level minus 2.
+ * @return The center of the node (one level below it), 2^step generations ahead.
+ */
+HashLife::Node* HashLife::successor(Node* node, int step) {
+  if (node->population == 0) { return empty(node->level - 1); }
+  if (node->result != nullptr && node->result_step == step) { return node->result; }
+
+  Node* result;
+  if (node->level == 2) {
+    result = step_square(node);
+  } else {
+    Node* a = node->nw;
+    Node* b = node->ne;
+    Node* c = node->sw;
+    Node* d = node->se;
+
+    Node* squares[3][3] = {
+      { a, join(a->ne, b->nw, a->se, b->sw), b },
+      { join(a->sw, a->se, c->nw, c->ne), join(a->se, b->sw, c->ne, d->nw), join(b->sw, b->se, d->nw, d->ne) },
+      { c, join(c->ne, d->nw, c->se, d->sw), d },
+    };
+
+    const bool full_step = step == static_cast<int>(node->level) - 2;
+    for (auto& line : squares) {
+      for (auto& square : line) { square = full_step ? successor(square, step - 1) : center(square); }
+    }
+
+    const int remaining = full_step ? step - 1 : step;
+    result = join(successor(join(squares[0][0], squares[0][1], squares[1][0], squares[1][1]), remaining),
+                  successor(join(squares[0][1], squares[0][2], squares[1][1], squares[1][2]), remaining),
+                  successor(join(squares[1][0], squares[1][1], squares[2][0], squares[2][1]), remaining),
+                  successor(join(squares[1][1], squares[1][2], squares[2][1], squares[2][2]), remaining));
+  }
+
+  node->result = result;
+  node->result_step = step;
+  return result;
+}
+
+/*!
+ * Advances the plane 2^step generations.
+ *
+ * The root is first expanded until the pattern fits in its innermost
+ * quarter, so it cannot reach past the returned center during the jump.
+ * @param step Log2 of the generations.
+ */
+void HashLife::advance_pow2(int step) {
+  if (m_nodes.size() > m_node_limit) { collect(); }
+
+  auto inner_population = [this]() {
+    return m_root->nw->se->se->population + m_root->ne->sw->sw->population
+           + m_root->sw->ne->ne->population + m_root->se->nw->nw->population;
+  };
+  while (static_cast<int>(m_root->level) < step + 3 || inner_population() != m_root->population) {
+    expand();
+  }
+
+  const int64_t shift = int64_t{ 1 } << (m_root->level - 2);
+  m_root = successor(m_root, step);
+  m_origin_row += shift;
+  m_origin_col += shift;
+  shrink();
+}
+
+/*!
+ * Advances any number of generations, as a sum of jumps of powers of two.
+ * @param generations Number of generations.
+ */
+void HashLife::advance(uint64_t generations) {
+  for (int step = 0; generations != 0; ++step, generations >>= 1) {
+    if (generations & 1U) { advance_pow2(step); }
+  }
+}
+
+/*!
+ * Copies a node (and its quadrants) into the current storage.
+ * @param node The node in the previous storage.
+ * @param moved Nodes already copied, by their previous address.
+ * @return The node in the current storage.
+ */
+HashLife::Node* HashLife::copy(const Node* node, std::unordered_map<const Node*, Node*>& moved) {
+  if (node->level == 0) { return node->population != 0 ? m_alive : m_dead; }
+  if (node->population == 0) { return empty(node->level); }
+
+  auto it = moved.find(node);
+  if (it != moved.end()) { return it->second; }
+
+  Node* clone = join(copy(node->nw, moved), copy(node->ne, moved), copy(node->sw, moved), copy(node->se, moved));
+  moved.emplace(node, clone);
+  return clone;
+}
+
+/*!
+ * Rebuilds the storage with the nodes still reachable from the root.
+ * Memoized results are lost, so this only happens when the node limit is exceeded.
+ */
+void HashLife::collect() {
+  std::deque<Node> previous;
+  previous.swap(m_nodes);
+  ++m_collections;
+  m_table.clear();
+  m_empty.clear();
+
+  m_dead = make_leaf(false);
+  m_alive = make_leaf(true);
+
+  std::unordered_map<const Node*, Node*> moved;
+  m_root = copy(m_root, moved);
+}
+
+/*!
+ * Marks the alive cells of a node whose top-left cell is (row, col) in the window.
+ * Only the cells inside the board window are written.
+ * @param node The node.
+ * @param row Board row of the top-left cell of the node.
+ * @param col Board column of the top-left cell of the node.
+ */
+void HashLife::fill(const Node* node, int64_t row, int64_t col) {
+  const int64_t side = int64_t{ 1 } << node->level;
+  if (node->population == 0 || row > static_cast<int64_t>(m_rows) || col > static_cast<int64_t>(m_cols)
+      || row + side <= 1 || col + side <= 1) {
+    return;
+  }
+
+  if (node->level == 0) {
+    m_window[static_cast<size_t>(row - 1) * m_cols + static_cast<size_t>(col - 1)] = 1;
+    return;
+  }
+
+  const int64_t half = side / 2;
+  fill(node->nw, row, col);
+  fill(node->ne, row, col + half);
+  fill(node->sw, row + half, col);
+  fill(node->se, row + half, col + half);
+}
+
+/*!
+ * Writes the board window of the plane into the board cells.
+ * The window is drawn apart first, so only the cells that flip are recorded.
+ * @param cfg The board that receives the current generation.
+ */
+void HashLife::store(LifeCfg& cfg) {
+  std::fill(m_window.begin(), m_window.end(), 0);
+  fill(m_root, m_origin_row, m_origin_col);
+
+  for (size_t r = 1; r <= m_rows; ++r) {
+    const uint8_t* row = &m_window[(r - 1) * m_cols];
+    for (size_t c = 1; c <= m_cols; ++c) { cfg.set_alive(r, c, row[c - 1] != 0); }
+  }
+}
+
+}  // namespace life
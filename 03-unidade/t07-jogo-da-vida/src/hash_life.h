@@ -0,0 +1,135 @@
+#ifndef HASH_LIFE_H
+#define HASH_LIFE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include "engine.h"
+
+namespace life {
+
+/*!
+ * HashLife engine, able to jump over huge numbers of generations.
+ *
+ * The plane is stored as a quadtree whose nodes are canonical: two regions
+ * with the same contents are the same node, so repeated structures are
+ * stored (and computed) once. Each node of level `L` (a square with side
+ * `2^L`) memoizes its center square `2^(L-2)` generations ahead, which lets
+ * `advance()` move in jumps of powers of two.
+ *
+ * Unlike the other engines, HashLife always simulates an unbounded plane:
+ * cells that leave the board keep evolving outside of it. `store()` writes the
+ * window of the original board, so the output only matches the bounded
+ * engines while the pattern stays away from the board edges.
+ */
+class HashLife : public Engine {
+public:
+  //=== Special members
+  /// Constructor
+  explicit HashLife(size_t node_limit = 1000000);
+  /// Destructor
+  ~HashLife() override = default;
+
+  //=== Engine interface.
+  /// Builds the quadtree with the alive cells of a board.
+  void load(const LifeCfg& cfg) override;
+  /// Advances one generation.
+  void step() override { advance(1); }
+  /// Advances any number of generations, in jumps of powers of two.
+  void advance(uint64_t generations) override;
+  /// Writes the board window of the plane into the board cells.
+  void store(LifeCfg& cfg) override;
+  /// Number of alive cells in the whole plane.
+  [[nodiscard]] size_t population() const override { return m_root->population; }
+  /// Describes the plane by its root node, which only depends on the live cells, and where the root lies.
+  bool plane_key(std::vector<uint64_t>& key) const override;
+  /// Writes the live cells of the plane, as a box placed relative to the window.
+  bool save_plane(std::vector<uint64_t>& plane) const override;
+  /// Builds the quadtree with the live cells of a plane, around the window of a board.
+  bool load_plane(const LifeCfg& cfg, const std::vector<uint64_t>& plane) override;
+  /// Accepts the plane, which it always simulates, and not a torus.
+  bool set_topology(e_topology topology) override;
+  /// Selects the rule of the next steps, any rule but the ones with B0.
+  bool set_rule(const Rule& rule) override;
+
+  //=== Attribute accessors members.
+  /// Sets how many nodes may be stored before unused ones are discarded.
+  void set_node_limit(size_t limit) { m_node_limit = limit; }
+  /// Number of nodes currently stored.
+  [[nodiscard]] size_t node_count() const { return m_nodes.size(); }
+
+private:
+  /// A square region of the plane, with side 2^level.
+  struct Node {
+    Node* nw;             //!< North-west quadrant (null for a single cell).
+    Node* ne;             //!< North-east quadrant.
+    Node* sw;             //!< South-west quadrant.
+    Node* se;             //!< South-east quadrant.
+    uint64_t population;  //!< Number of alive cells in the region.
+    unsigned level;       //!< Log2 of the region side.
+    Node* result;         //!< Memoized center of the region, 2^result_step generations ahead.
+    int result_step;      //!< Log2 of the generations of the memoized result, -1 if none.
+  };
+  /// Identifies a node by its quadrants.
+  typedef std::array<const Node*, 4> key_t;
+  /// Hash of a node key.
+  struct KeyHash {
+    size_t operator()(const key_t& key) const;
+  };
+
+  /// Returns the canonical node with the given quadrants.
+  Node* join(Node* nw, Node* ne, Node* sw, Node* se);
+  /// Returns the canonical empty node of a level.
+  Node* empty(unsigned level);
+  /// Creates a node holding a single cell.
+  Node* make_leaf(bool alive);
+  /// Builds the node of a level whose top-left cell is (row, col) of a board.
+  Node* build(const LifeCfg& cfg, unsigned level, size_t row, size_t col);
+  /// Builds the node of a level whose top-left cell is (row, col) of a plane written by save_plane().
+  Node* build(const std::vector<uint64_t>& plane, unsigned level, int64_t row, int64_t col);
+  /// Finds the bounding box of the live cells of a node whose top-left cell is (row, col).
+  void bounds(const Node* node, int64_t row, int64_t col, int64_t box[4]) const;
+  /// Sets the bits of the live cells of a node whose top-left cell is (row, col) in a plane box.
+  void pack(const Node* node, int64_t row, int64_t col, std::vector<uint64_t>& plane) const;
+  /// Returns the center of a node, with half of its side.
+  Node* center(Node* node);
+  /// Surrounds the root with empty space, doubling its side.
+  void expand();
+  /// Replaces the root by its center while the center holds every live cell.
+  void shrink();
+  /// Computes the center of a level 2 node one generation ahead.
+  Node* step_square(Node* node);
+  /// Computes the center of a node 2^step generations ahead.
+  Node* successor(Node* node, int step);
+  /// Advances the plane 2^step generations.
+  void advance_pow2(int step);
+  /// Rebuilds the storage with the nodes still reachable from the root.
+  void collect();
+  /// Copies a node (and its quadrants) into the current storage.
+  Node* copy(const Node* node, std::unordered_map<const Node*, Node*>& moved);
+  /// Marks the alive cells of a node whose top-left cell is (row, col) in the window.
+  void fill(const Node* node, int64_t row, int64_t col);
+
+  std::deque<Node> m_nodes;                           //!< Storage of every node.
+  std::unordered_map<key_t, Node*, KeyHash> m_table;  //!< Canonical nodes by their quadrants.
+  std::vector<Node*> m_empty;                         //!< Canonical empty node of each level.
+  Node* m_dead{ nullptr };                            //!< The dead cell.
+  Node* m_alive{ nullptr };                           //!< The alive cell.
+  Node* m_root{ nullptr };                            //!< The plane.
+  int64_t m_origin_row{ 1 };                          //!< Board row of the root's top-left cell.
+  int64_t m_origin_col{ 1 };                          //!< Board column of the root's top-left cell.
+  size_t m_rows{ 0 };                                 //!< Number of rows of the board window.
+  size_t m_cols{ 0 };                                 //!< Number of columns of the board window.
+  std::vector<uint8_t> m_window;                      //!< Cells of the board window, written by store().
+  uint64_t m_collections{ 0 };                        //!< Number of collections, which move every node.
+  size_t m_node_limit;                                //!< Nodes stored before a collection.
+  StateTable m_states{ ConwayRule::table };          //!< Next state of a cell under the rule.
+};
+
+}  // namespace life
+
+#endif  // HASH_LIFE_H
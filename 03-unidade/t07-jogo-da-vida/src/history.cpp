@@ -0,0 +1,245 @@
+/*!
+ * HistoryStore class implementation.
+ * @file history.cpp
+ */
+
+#include "history.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace life {
+
+/*!
+ * Creates an empty history.
+ * @param keyframe_every Boards of each segment, at least one.
+ * @param memory_cap Maximum bytes kept, zero for no limit.
+ */
+HistoryStore::HistoryStore(size_t keyframe_every, size_t memory_cap)
+    : m_keyframe_every(std::max<size_t>(keyframe_every, 1)), m_memory_cap(memory_cap) {}
+
+/*!
+ * Appends the next board of the history: as the keyframe of a new segment
+ * when the last one is full (or the board size changed), or as the
+ * run-length encoded XOR with the previous board otherwise.
+ * @param board The bit-packed board.
+ */
+void HistoryStore::push(const board_t& board) {
+  const bool keyframe = m_segments.empty() || m_segments.back().ends.size() + 1 >= m_keyframe_every
+                        || board.size() != m_last.size();
+
+  if (keyframe) {
+    /// Release the slack of the finished segment before starting the next one.
+    if (!m_segments.empty()) {
+      Segment& finished = m_segments.back();
+      m_memory -= bytes(finished);
+      finished.deltas.shrink_to_fit();
+      finished.ends.shrink_to_fit();
+      m_memory += bytes(finished);
+    }
+    m_segments.push_back(Segment{ m_size, board, {}, {} });
+    m_memory += bytes(m_segments.back());
+  } else {
+    Segment& segment = m_segments.back();
+    m_memory -= bytes(segment);
+
+    /// Runs of changed words, each behind a header with the words skipped before it and its length.
+    size_t done = 0;  //!<- End of the last run.
+    for (size_t i = 0; i < board.size();) {
+      if (board[i] == m_last[i]) {
+        ++i;
+        continue;
+      }
+      const size_t start = i;
+      while (i < board.size() && board[i] != m_last[i]) { ++i; }
+      segment.deltas.push_back(static_cast<uint64_t>(start - done) << 32 | static_cast<uint64_t>(i - start));
+      for (size_t w = start; w < i; ++w) { segment.deltas.push_back(board[w] ^ m_last[w]); }
+      done = i;
+    }
+    segment.ends.push_back(segment.deltas.size());
+    m_memory += bytes(segment);
+  }
+
+  m_last = board;
+  ++m_size;
+  evict();
+}
+
+/*!
+ * Rebuilds the board of an index from the keyframe of its segment.
+ * @param index Index of the board, in the order they were pushed.
+ * @param board Receives the board.
+ * @return true if the board is still kept, false if it was evicted or never pushed.
+ */
+bool HistoryStore::get(size_t index, board_t& board) const {
+  if (index < first() || index >= m_size) { return false; }
+
+  /// The segment of the board is the last one that starts at or before it.
+  auto segment = std::upper_bound(m_segments.begin(), m_segments.end(), index,
+                                  [](size_t i, const Segment& s) { return i < s.first; });
+  --segment;
+
+  board = segment->keyframe;
+  for (size_t delta = 0; delta < index - segment->first; ++delta) { apply(*segment, delta, board); }
+  return true;
+}
+
+/*!
+ * Calls a function with each kept board of the indices in [first, last), in
+ * order, rebuilding them one from the other instead of from their keyframes.
+ * @param first Index of the first board.
+ * @param last Index past the last board.
+ * @param visit Function called with the index and the board.
+ */
+void HistoryStore::for_each(size_t first, size_t last, const std::function<void(size_t, const board_t&)>& visit) const {
+  first = std::max(first, this->first());
+  last = std::min(last, m_size);
+  if (first >= last) { return; }
+
+  auto segment = std::upper_bound(m_segments.begin(), m_segments.end(), first,
+                                  [](size_t i, const Segment& s) { return i < s.first; });
+  --segment;
+
+  board_t board;
+  get(first, board);
+  visit(first, board);
+
+  for (size_t index = first + 1; index < last; ++index) {
+    if (std::next(segment) != m_segments.end() && std::next(segment)->first == index) {
+      ++segment;
+      board = segment->keyframe;
+    } else {
+      apply(*segment, index - segment->first - 1, board);
+    }
+    visit(index, board);
+  }
+}
+
+/*!
+ * Forgets every board.
+ */
+void HistoryStore::clear() {
+  m_segments.clear();
+  m_last.clear();
+  m_memory = 0;
+  m_size = 0;
+}
+
+/*!
+ * Changes the keyframe interval and the memory cap, forgetting every board.
+ * @param keyframe_every Boards of each segment, at least one.
+ * @param memory_cap Maximum bytes kept, zero for no limit.
+ */
+void HistoryStore::configure(size_t keyframe_every, size_t memory_cap) {
+  clear();
+  m_keyframe_every = std::max<size_t>(keyframe_every, 1);
+  m_memory_cap = memory_cap;
+}
+
+/*!
+ * Copies the segments holding the boards from an index on into another
+ * history, which is emptied first and keeps its own settings. Segments
+ * before the one holding the index never change again, so the copy is what
+ * may have changed since a copy made when the index was the last board.
+ * @param index Index of the first board copied.
+ * @param tail Receives the segments, and the number of boards pushed so far.
+ */
+void HistoryStore::copy_tail(size_t index, HistoryStore& tail) const {
+  tail.clear();
+  tail.m_size = m_size;
+  if (m_segments.empty()) { return; }
+
+  auto segment = std::upper_bound(m_segments.begin(), m_segments.end(), index,
+                                  [](size_t i, const Segment& s) { return i < s.first; });
+  if (segment != m_segments.begin()) { --segment; }
+  for (; segment != m_segments.end(); ++segment) {
+    tail.m_segments.push_back(*segment);
+    tail.m_memory += bytes(tail.m_segments.back());
+  }
+}
+
+/*!
+ * Takes the segments of a history filled by a newer copy_tail() of the same
+ * boards: they replace the segments that start with or after their first
+ * one, and the segments before a board (evicted from the copied history)
+ * are dropped. The tail is left empty.
+ * @param tail The newer segments.
+ * @param first Index of the first board still kept by the copied history.
+ */
+void HistoryStore::splice(HistoryStore&& tail, size_t first) {
+  if (!tail.m_segments.empty()) {
+    const size_t start = tail.m_segments.front().first;
+    while (!m_segments.empty() && m_segments.back().first >= start) { m_segments.pop_back(); }
+    for (auto& segment : tail.m_segments) { m_segments.push_back(std::move(segment)); }
+  }
+  while (!m_segments.empty() && m_segments.front().first < first) { m_segments.pop_front(); }
+  m_size = tail.m_size;
+  tail.clear();
+  rebuild();
+}
+
+/*!
+ * Replaces every board with segments read back, e.g. from a checkpoint.
+ * @param segments The segments, oldest first, as returned by segments().
+ * @param size Number of boards pushed, kept or evicted.
+ */
+void HistoryStore::assign(std::deque<Segment> segments, size_t size) {
+  m_segments = std::move(segments);
+  m_size = size;
+  rebuild();
+}
+
+/*!
+ * Recomputes the memory used and the last board after the segments were
+ * replaced, evicting segments over the cap.
+ */
+void HistoryStore::rebuild() {
+  m_memory = 0;
+  for (const auto& segment : m_segments) { m_memory += bytes(segment); }
+  /// The next board pushed is encoded against the last one.
+  if (!get(m_size - 1, m_last)) { m_last.clear(); }
+  evict();
+}
+
+/*!
+ * Bytes used by a segment, counting the capacity of its vectors.
+ * @param segment The segment.
+ * @return The bytes used.
+ */
+size_t HistoryStore::bytes(const Segment& segment) {
+  return sizeof(Segment) + (segment.keyframe.capacity() + segment.deltas.capacity()) * sizeof(uint64_t)
+         + segment.ends.capacity() * sizeof(size_t);
+}
+
+/*!
+ * Applies the delta of a board of a segment to the board before it.
+ * @param segment The segment.
+ * @param delta Which delta of the segment, zero for the board after the keyframe.
+ * @param board The board before it, which receives the board.
+ */
+void HistoryStore::apply(const Segment& segment, size_t delta, board_t& board) {
+  size_t p = delta == 0 ? 0 : segment.ends[delta - 1];
+  size_t word = 0;
+
+  while (p < segment.ends[delta]) {
+    const uint64_t header = segment.deltas[p++];
+    word += static_cast<size_t>(header >> 32);
+    for (size_t count = static_cast<size_t>(header & 0xFFFFFFFFULL); count > 0; --count) {
+      board[word++] ^= segment.deltas[p++];
+    }
+  }
+}
+
+/*!
+ * Evicts the oldest segments while the memory cap is exceeded, always
+ * keeping the segment being filled.
+ */
+void HistoryStore::evict() {
+  while (m_memory_cap > 0 && m_memory > m_memory_cap && m_segments.size() > 1) {
+    m_memory -= bytes(m_segments.front());
+    m_segments.pop_front();
+  }
+}
+
+}  // namespace life
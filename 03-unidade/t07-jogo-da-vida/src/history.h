@@ -0,0 +1,92 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace life {
+
+/*!
+ * Compact history of the bit-packed boards of a simulation.
+ *
+ * The boards are split in segments of `keyframe_every` consecutive boards.
+ * A segment keeps its first board whole (the keyframe) and each of the
+ * others as the XOR with the board before it, run-length encoded: only the
+ * words that changed are stored, behind a header word with the number of
+ * unchanged words skipped and of changed words that follow. A board is
+ * rebuilt from the keyframe of its segment by applying the deltas up to it.
+ *
+ * When a memory cap is set, the oldest segments are evicted to keep the
+ * history under it; the segment being filled is always kept.
+ */
+class HistoryStore {
+public:
+  //=== Alias
+  typedef std::vector<uint64_t> board_t;  //!< A bit-packed board.
+
+  /// A keyframe and the deltas of the boards that follow it.
+  struct Segment {
+    size_t first;                  //!< Index of the keyframe.
+    board_t keyframe;              //!< The first board, whole.
+    std::vector<uint64_t> deltas;  //!< Run-length encoded XOR of each following board with the previous one.
+    std::vector<size_t> ends;      //!< End of the delta of each following board in `deltas`.
+  };
+
+  //=== Special members
+  /// Constructor
+  explicit HistoryStore(size_t keyframe_every = 64, size_t memory_cap = 0);
+
+  //=== Members
+  /// Appends the next board of the history.
+  void push(const board_t& board);
+  /// Rebuilds the board of an index, telling whether it is still kept.
+  bool get(size_t index, board_t& board) const;
+  /// Calls a function with each kept board of the indices in [first, last), in order.
+  void for_each(size_t first, size_t last, const std::function<void(size_t, const board_t&)>& visit) const;
+  /// Forgets every board.
+  void clear();
+  /// Changes the keyframe interval and the memory cap, forgetting every board.
+  void configure(size_t keyframe_every, size_t memory_cap);
+  /// Copies the segments holding the boards from an index on into another history.
+  void copy_tail(size_t index, HistoryStore& tail) const;
+  /// Takes the segments of a newer copy_tail(), replacing the ones they overlap, and drops the segments before a board.
+  void splice(HistoryStore&& tail, size_t first);
+  /// Replaces every board with segments read back, e.g. from a checkpoint.
+  void assign(std::deque<Segment> segments, size_t size);
+
+  //=== Attribute accessors members.
+  /// Number of boards pushed so far, kept or evicted.
+  [[nodiscard]] size_t size() const { return m_size; }
+  /// Index of the first board still kept.
+  [[nodiscard]] size_t first() const { return m_segments.empty() ? m_size : m_segments.front().first; }
+  /// Bytes used by the kept boards.
+  [[nodiscard]] size_t memory() const { return m_memory; }
+  /// Number of boards evicted to respect the memory cap.
+  [[nodiscard]] size_t evicted() const { return first(); }
+  /// Kept segments, oldest first.
+  [[nodiscard]] const std::deque<Segment>& segments() const { return m_segments; }
+
+private:
+  /// Bytes used by a segment.
+  static size_t bytes(const Segment& segment);
+  /// Applies the delta of a board of a segment to the board before it.
+  static void apply(const Segment& segment, size_t delta, board_t& board);
+  /// Evicts the oldest segments while the memory cap is exceeded.
+  void evict();
+  /// Recomputes the memory used and the last board after the segments were replaced.
+  void rebuild();
+
+  std::deque<Segment> m_segments;  //!< Kept segments, oldest first.
+  board_t m_last;                  //!< The last board pushed.
+  size_t m_keyframe_every;         //!< Boards of each segment.
+  size_t m_memory_cap;             //!< Maximum bytes kept, zero for no limit.
+  size_t m_memory{ 0 };            //!< Bytes used by the kept segments.
+  size_t m_size{ 0 };              //!< Number of boards pushed.
+};
+
+}  // namespace life
+
+#endif  // HISTORY_H
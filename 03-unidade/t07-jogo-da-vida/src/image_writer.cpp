@@ -0,0 +1,254 @@
+/*!
+ * ImageWriter class implementation.
+ * @file image_writer.cpp
+ */
+
+#include "image_writer.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "life.h"
+#include "lodepng.h"
+
+namespace life {
+
+/*!
+ * Opens the output and starts the encoder threads.
+ * @param conf The configuration, with the output kind, colors, block size and path of the images.
+ * @param n_encoders Number of encoder threads (at least one is started).
+ * @param capacity Maximum number of frames waiting in the queue (at least one).
+ */
+ImageWriter::ImageWriter(Config& conf, size_t n_encoders, size_t capacity)
+    : m_output(conf.get_output()), m_alive(conf.get_alive_color()), m_bkg(conf.get_bkg_color()),
+      m_block_size(conf.get_block_size()), m_palette(conf.get_color_mode() == "palette"),
+      m_deflate{ conf.get_deflate_window(), conf.get_deflate_nicematch(), conf.get_deflate_lazy() },
+      m_path(conf.get_path()),
+      m_capacity(std::max<size_t>(capacity, 1)) {
+  if (m_output == "apng") {
+    m_destination = m_path + "/" + conf.get_apng_file();
+    m_apng.open(m_destination, static_cast<unsigned>(conf.get_fps()));
+  } else if (m_output == "raw") {
+    m_destination = conf.get_raw_target();
+    m_raw = m_destination == "-" ? stdout : std::fopen(m_destination.c_str(), "wb");
+    if (m_raw == nullptr) {
+      throw std::runtime_error("Unable to open the raw output [" + m_destination + "].");
+    }
+  } else {
+    m_destination = m_path;
+  }
+
+  for (size_t i = 0; i < std::max<size_t>(n_encoders, 1); ++i) {
+    m_encoders.emplace_back(&ImageWriter::encoder_loop, this);
+  }
+}
+
+/// Destructor, waits for the queued images.
+ImageWriter::~ImageWriter() { finish(); }
+
+/*!
+ * Queues the image of a generation, waiting if the queue is full.
+ * @param cfg The board of the generation.
+ * @param generation The generation number, used in the file name.
+ */
+void ImageWriter::push(const LifeCfg& cfg, int generation) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_not_full.wait(lock, [this] { return m_queue.size() < m_capacity; });
+
+  Frame frame;
+  if (!m_free.empty()) {
+    frame = std::move(m_free.back());
+    m_free.pop_back();
+  }
+  frame.sequence = m_pushed++;
+  lock.unlock();
+
+  /// Update the snapshot outside the lock, the encoders may keep working meanwhile.
+  const size_t rows = cfg.m_rows;
+  const size_t cols = cfg.m_cols;
+  const size_t words = (rows * cols + 63) / 64;
+  frame.has_changes = m_snapshot.size() == words && cfg.update_count() == m_snapshot_updates + 1;
+  frame.changed.clear();
+
+  if (frame.has_changes) {
+    /// The snapshot holds the previous generation: apply only the cells that flipped.
+    for (size_t r = 1; r <= rows; ++r) {
+      for (const uint32_t c : cfg.changed_cells(r)) {
+        const size_t index = (r - 1) * cols + (c - 1);
+        const uint64_t mask = uint64_t{ 1 } << (index % 64);
+        if (cfg.get_cell(r, c).is_alive) { m_snapshot[index / 64] |= mask; }
+        else { m_snapshot[index / 64] &= ~mask; }
+        frame.changed.push_back(index);
+      }
+    }
+  } else {
+    m_snapshot.assign(words, 0);
+    size_t index = 0;
+    for (size_t r = 1; r <= rows; ++r) {
+      for (size_t c = 1; c <= cols; ++c, ++index) {
+        if (cfg.get_cell(r, c).is_alive) { m_snapshot[index / 64] |= uint64_t{ 1 } << (index % 64); }
+      }
+    }
+  }
+  m_snapshot_updates = cfg.update_count();
+
+  frame.generation = generation;
+  frame.rows = rows;
+  frame.cols = cols;
+  frame.bits = m_snapshot;
+
+  lock.lock();
+  m_queue.push_back(std::move(frame));
+  lock.unlock();
+  m_not_empty.notify_one();
+}
+
+/*!
+ * Main loop of an encoder thread: takes frames until the writer is finished.
+ * Each encoder keeps its own PNG encoder and output buffer from one frame to the next.
+ */
+void ImageWriter::encoder_loop() {
+  PngEncoder encoder(m_alive, m_bkg, m_block_size, m_palette, m_deflate);
+  std::vector<unsigned char> bytes;
+
+  for (;;) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_not_empty.wait(lock, [this] { return m_done || !m_queue.empty(); });
+    if (m_queue.empty()) { return; }
+
+    Frame frame = std::move(m_queue.front());
+    m_queue.pop_front();
+    lock.unlock();
+    m_not_full.notify_one();
+
+    encode(frame, encoder, bytes);
+
+    lock.lock();
+    m_free.push_back(std::move(frame));
+  }
+}
+
+/*!
+ * Encodes a frame and saves it as a PNG file, or hands it to the stream.
+ * @param frame The frame.
+ * @param encoder Draws and encodes the images.
+ * @param bytes Buffer that receives the encoded frame.
+ * @return true if the image was saved (or queued for the stream), false otherwise.
+ */
+bool ImageWriter::encode(const Frame& frame, PngEncoder& encoder, std::vector<unsigned char>& bytes) {
+  const auto start = std::chrono::steady_clock::now();
+
+  if (m_output == "raw") {
+    const Canvas& image = encoder.render_rgba(frame);
+    bytes.assign(image.pixels(), image.pixels() + image.width() * image.height() * Canvas::image_depth);
+    report(frame, true, bytes.size(), std::chrono::steady_clock::now() - start);
+    return commit(frame.sequence, std::move(bytes));
+  }
+
+  bool success = encoder.encode(frame, bytes);
+  const auto elapsed = std::chrono::steady_clock::now() - start;  //!<- Writing the file is not counted.
+
+  if (success && m_output == "png") {
+    success = lodepng::save_file(bytes, LifeCfg::generate_filename(m_path, frame.generation)) == 0U;
+  }
+  report(frame, success, bytes.size(), elapsed);
+  if (m_output != "apng") { return success; }
+
+  /// A frame that failed is still committed, empty, so the frames after it are not held back.
+  if (!success) { bytes.clear(); }
+  return commit(frame.sequence, std::move(bytes)) && success;
+}
+
+/*!
+ * Records the outcome of a frame.
+ * @param frame The frame.
+ * @param success Whether the frame was saved.
+ * @param bytes Size of the encoded frame.
+ * @param elapsed Time spent drawing and encoding the frame.
+ */
+void ImageWriter::report(const Frame& frame, bool success, size_t bytes, std::chrono::nanoseconds elapsed) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (success) {
+    ++m_saved;
+    m_bytes += bytes;
+    m_elapsed += elapsed;
+  } else if (m_output == "png") {
+    m_failed.push_back(LifeCfg::generate_filename(m_path, frame.generation));
+  } else {
+    m_failed.push_back("generation " + std::to_string(frame.generation));
+  }
+}
+
+/*!
+ * Keeps an encoded frame and writes, in order, every frame of the stream that is ready.
+ * A frame whose encoding failed is committed empty and skipped by the stream.
+ * @param sequence Order in which the frame was pushed.
+ * @param bytes The encoded frame, empty if it failed.
+ * @return true if the writes succeeded, false otherwise.
+ */
+bool ImageWriter::commit(size_t sequence, std::vector<unsigned char>&& bytes) {
+  std::lock_guard<std::mutex> lock(m_stream_mutex);
+  m_ready.emplace(sequence, std::move(bytes));
+
+  bool success = true;
+  for (auto it = m_ready.find(m_next_sequence); it != m_ready.end(); it = m_ready.find(m_next_sequence)) {
+    if (!it->second.empty()) { success = write_stream(it->second) && success; }
+    m_ready.erase(it);
+    ++m_next_sequence;
+  }
+  return success;
+}
+
+/*!
+ * Writes one frame of the stream.
+ * @param bytes The encoded frame: a PNG for apng, the RGBA pixels for raw.
+ * @return true if the frame was written, false otherwise.
+ */
+bool ImageWriter::write_stream(const std::vector<unsigned char>& bytes) {
+  if (m_raw != nullptr) {
+    return std::fwrite(bytes.data(), 1, bytes.size(), m_raw) == bytes.size();
+  }
+  return m_apng.add_frame(bytes);
+}
+
+/*!
+ * Average size of the encoded images.
+ * @return The size in bytes, or zero if no image was saved.
+ */
+double ImageWriter::bytes_per_frame() const {
+  return m_saved == 0 ? 0.0 : static_cast<double>(m_bytes) / static_cast<double>(m_saved);
+}
+
+/*!
+ * Average time an encoder spent drawing and encoding an image.
+ * @return The time in milliseconds, or zero if no image was saved.
+ */
+double ImageWriter::ms_per_frame() const {
+  return m_saved == 0 ? 0.0 : std::chrono::duration<double, std::milli>(m_elapsed).count() / static_cast<double>(m_saved);
+}
+
+/*!
+ * Waits for every queued image to be saved, stops the encoders and closes the stream.
+ */
+void ImageWriter::finish() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_done = true;
+  }
+  m_not_empty.notify_all();
+  for (auto& encoder : m_encoders) {
+    if (encoder.joinable()) { encoder.join(); }
+  }
+
+  m_apng.close();
+  if (m_raw != nullptr) {
+    if (m_raw == stdout) {
+      std::fflush(m_raw);
+    } else {
+      std::fclose(m_raw);
+    }
+    m_raw = nullptr;
+  }
+}
+
+}  // namespace life
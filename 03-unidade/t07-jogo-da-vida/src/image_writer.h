@@ -0,0 +1,128 @@
+#ifndef IMAGE_WRITER_H
+#define IMAGE_WRITER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "apng_stream.h"
+#include "canvas.h"
+#include "config.h"
+#include "frame.h"
+#include "png_encoder.h"
+
+namespace life {
+
+class LifeCfg;
+
+/*!
+ * Renders and saves the image of each generation off the simulation thread.
+ *
+ * The simulation pushes a bit-packed snapshot of the board into a bounded
+ * queue and goes on; a few encoder threads take snapshots from the queue
+ * and draw them on their own canvas. When the queue is full, `push()` waits
+ * for an encoder to take a snapshot, so a slow disk cannot make memory grow
+ * without bound.
+ *
+ * The output may be:
+ * - `png`: one `gen_XXXXX.png` file per generation. Images may be finished
+ *   out of order, but each one is named after its own generation.
+ * - `apng`: a single animated PNG with every generation.
+ * - `raw`: the RGBA pixels of every generation, written back to back to a
+ *   file, a FIFO or the standard output, to be piped into a video encoder.
+ *
+ * For the last two, frames finished early wait until every previous frame
+ * is written, so the stream is always in generation order.
+ *
+ * The snapshot of each generation is kept up to date from the cells that
+ * flipped in the last update, so preparing a frame costs a copy of the
+ * bits plus the changes, not a visit to every cell. PNG images are drawn
+ * and encoded by a PngEncoder kept by each encoder thread, which also
+ * redraws only the cells that changed.
+ */
+class ImageWriter {
+public:
+  //=== Special members
+  /// Constructor, opens the output and starts the encoder threads.
+  ImageWriter(Config& conf, size_t n_encoders, size_t capacity);
+  /// Destructor, waits for the queued images.
+  ~ImageWriter();
+  /// A writer owns its threads, so it cannot be copied.
+  ImageWriter(const ImageWriter&) = delete;
+  /// A writer owns its threads, so it cannot be assigned.
+  ImageWriter& operator=(const ImageWriter&) = delete;
+
+  //=== Members
+  /// Queues the image of a generation, waiting if the queue is full.
+  void push(const LifeCfg& cfg, int generation);
+  /// Waits for every queued image to be saved and stops the encoders.
+  void finish();
+
+  //=== Attribute accessors members.
+  /// Number of images saved successfully.
+  [[nodiscard]] size_t saved() const { return m_saved; }
+  /// Images that could not be saved.
+  [[nodiscard]] const std::vector<std::string>& failed() const { return m_failed; }
+  /// Where the images are saved: a directory, the animation file or the raw stream.
+  [[nodiscard]] const std::string& destination() const { return m_destination; }
+  /// Average size of the encoded images, in bytes.
+  [[nodiscard]] double bytes_per_frame() const;
+  /// Average time spent drawing and encoding an image, in milliseconds.
+  [[nodiscard]] double ms_per_frame() const;
+
+private:
+  /// Main loop of an encoder thread.
+  void encoder_loop();
+  /// Encodes a frame and saves it or hands it to the stream.
+  bool encode(const Frame& frame, PngEncoder& encoder, std::vector<unsigned char>& bytes);
+  /// Writes the frames of the stream that are ready, in order.
+  bool commit(size_t sequence, std::vector<unsigned char>&& bytes);
+  /// Writes one frame of the stream.
+  bool write_stream(const std::vector<unsigned char>& bytes);
+  /// Records the outcome of a frame.
+  void report(const Frame& frame, bool success, size_t bytes, std::chrono::nanoseconds elapsed);
+
+  std::string m_output;                   //!< Kind of output: "png", "apng" or "raw".
+  std::string m_destination;              //!< Where the images are saved.
+  Color m_alive;                          //!< Color of alive cells.
+  Color m_bkg;                            //!< Color of dead cells.
+  size_t m_block_size;                    //!< Pixel size of each cell.
+  bool m_palette;                         //!< Whether PNG images are 1-bit palette images.
+  PngEncoder::Deflate m_deflate;          //!< Settings of the deflate compression.
+  std::string m_path;                     //!< Directory where the images are saved.
+  size_t m_capacity;                      //!< Maximum number of queued frames.
+  std::vector<std::thread> m_encoders;    //!< Encoder threads.
+
+  std::mutex m_mutex;                     //!< Guards the queue and the results below.
+  std::condition_variable m_not_empty;    //!< Signals a queued frame (or the end).
+  std::condition_variable m_not_full;     //!< Signals room in the queue.
+  std::deque<Frame> m_queue;              //!< Frames waiting to be encoded.
+  std::vector<Frame> m_free;              //!< Encoded frames, whose buffers are reused by push().
+  size_t m_pushed{ 0 };                   //!< Number of frames pushed.
+  size_t m_saved{ 0 };                    //!< Number of images saved successfully.
+  std::vector<std::string> m_failed;      //!< Images that could not be saved.
+  size_t m_bytes{ 0 };                    //!< Total size of the encoded images.
+  std::chrono::nanoseconds m_elapsed{ 0 };  //!< Total time spent drawing and encoding.
+  bool m_done{ false };                   //!< Tells the encoders that no frame will be pushed.
+
+  std::vector<uint64_t> m_snapshot;       //!< Last board pushed, kept up to date from the changed cells.
+  size_t m_snapshot_updates{ 0 };         //!< Update count of the board when the snapshot was taken.
+
+  std::mutex m_stream_mutex;              //!< Guards the stream members below.
+  std::map<size_t, std::vector<unsigned char>> m_ready;  //!< Encoded frames waiting for their turn.
+  size_t m_next_sequence{ 0 };            //!< Next frame to be written to the stream.
+  ApngStream m_apng;                      //!< Animated PNG output.
+  std::FILE* m_raw{ nullptr };            //!< Raw RGBA output.
+};
+
+}  // namespace life
+
+#endif  // IMAGE_WRITER_H
@@ -4,6 +4,20 @@
  */
 
 #include "life.h"
+#include "bit_board.h"
+#include "tile_board.h"
+#include "hash_life.h"
+#include "byte_board.h"
+#include "thread_pool.h"
+#include "mapped_file.h"
+#include "stats.h"
+#include "terminal.h"
+#include "frame_pacer.h"
+
+#include <charconv>
+#include <string_view>
+#include <type_traits>
+#include <unistd.h>
 
 namespace life {
 
@@ -36,15 +50,11 @@ bool Cell::operator==(const Cell& other) const {
 /// Basic constructor that creates a life board with all cells dead.
 LifeCfg::LifeCfg(size_t rows = 10, size_t cols = 10) : m_rows(rows), m_cols(cols) { fill_board(); }
 
-/// Copy constructor
-LifeCfg::LifeCfg(const LifeCfg& cfg) {
-  this->m_rows = cfg.m_rows;
-  this->m_cols = cfg.m_cols;
-  this->m_board.clear();
-  this->m_board.reserve(cfg.m_board.size());
-  for (const auto& cell : cfg.m_board) {
-    this->m_board.emplace_back(cell.row, cell.col, cell.is_alive);
-  }
+/// Copy constructor, the copy owns its own pair of buffers and lists of changed cells.
+LifeCfg::LifeCfg(const LifeCfg& cfg)
+    : m_rows(cfg.m_rows), m_cols(cfg.m_cols), m_board(cfg.m_board), m_next(cfg.m_board),
+      m_allocations(2), m_changed(cfg.m_rows + 2) {
+  reserve_changed();
 }
 
 /*!
@@ -67,11 +77,14 @@ void LifeCfg::print_game_of_life_intro() {
  * @param conf The configuration object containing color settings.
  */
 void LifeCfg::set_img(Canvas &img, Config &conf) {
-  for (const Cell &c : m_board) {
-    if (c.row > 0 && c.row <= m_rows && c.col > 0 && c.col <= m_cols) {
-      if (c.is_alive) { img.pixel(c.col - 1, c.row - 1, conf.get_alive_color()); } 
-      else { img.pixel(c.col - 1, c.row - 1, conf.get_bkg_color()); }
-    }
+  const Canvas::rgba_t alive = Canvas::rgba(conf.get_alive_color());
+  const Canvas::rgba_t bkg = Canvas::rgba(conf.get_bkg_color());
+  std::vector<Canvas::rgba_t> row(m_cols);  //!<- Colors of a row of cells.
+
+  /// Draw a whole row at a time; cells with the same color as before are skipped by the canvas.
+  for (size_t r = 1; r <= m_rows; ++r) {
+    for (size_t c = 1; c <= m_cols; ++c) { row[c - 1] = get_cell(r, c).is_alive ? alive : bkg; }
+    img.row(r - 1, row.data());
   }
 }
 
@@ -120,6 +133,17 @@ Cell& LifeCfg::get_cell(const size_t& r, const size_t& c) {
   return m_board[index];
 }
 
+/*!
+  * Returns a read-only reference to a cell stored in the board.
+  * @param r row of the cell
+  * @param c column of the cell
+  * @return Cell in the (r,c) position of the board
+  */
+const Cell& LifeCfg::get_cell(const size_t& r, const size_t& c) const {
+  const size_t index = r * get_expanded_cols() + c;
+  return m_board[index];
+}
+
 /*!
   * Returns a reference to a cell in the board in a position relative to another.
   * @param cell Central cell from which the info is coming from.
@@ -153,22 +177,31 @@ Cell& LifeCfg::get_neighbor(const Cell& cell, const e_cell_neighbor& orientation
  * @return size_t The number of alive neighboring cells.
  */
 size_t LifeCfg::get_alive_neighbor_count(const Cell& cell) {
-  std::vector<Cell> neighborhood{
-    get_neighbor(cell, e_cell_neighbor::LEFT), get_neighbor(cell, e_cell_neighbor::RIGHT),
-    get_neighbor(cell, e_cell_neighbor::UPPER), get_neighbor(cell, e_cell_neighbor::BELOW),
-    get_neighbor(cell, e_cell_neighbor::UPPER_LEFT), get_neighbor(cell, e_cell_neighbor::UPPER_RIGHT),
-    get_neighbor(cell, e_cell_neighbor::BELOW_LEFT), get_neighbor(cell, e_cell_neighbor::BELOW_RIGHT)
-  };
-  
   size_t count = 0;
 
-  for (const auto& neighbor_cell : neighborhood) {
-    if (neighbor_cell.is_alive)
+  /// Visit the neighbors in place, without copying them.
+  for (short direction = 0; direction <= short(e_cell_neighbor::BELOW_RIGHT); ++direction) {
+    if (get_neighbor(cell, e_cell_neighbor(direction)).is_alive)
       ++count;
   }
   return count;
 }
 
+/*!
+ * Sets whether a cell is alive. Engines store their generations through this
+ * method, so the cells that flip are recorded for changed_cells().
+ * @param r row of the cell
+ * @param c column of the cell
+ * @param alive Whether the cell is alive.
+ */
+void LifeCfg::set_alive(size_t r, size_t c, bool alive) {
+  Cell& cell = get_cell(r, c);
+  if (cell.is_alive != alive) {
+    cell.is_alive = alive;
+    m_changed[r].push_back(static_cast<uint32_t>(c));
+  }
+}
+
 ///=== Members.
 /*!
  * Equality operator for comparing two LifeCfg objects.
@@ -185,12 +218,39 @@ bool LifeCfg::operator==(const LifeCfg& other) const {
 }
 
 /*!
- * Fills the board with dead cells.
+ * Fills both board buffers with dead cells.
+ * The buffers are only reallocated when they are too small for the board.
  */
 void LifeCfg::fill_board() {
+  const size_t size = this->get_expanded_rows() * this->get_expanded_cols();
+
+  if (this->m_board.capacity() < size) { ++m_allocations; }
+  if (this->m_next.capacity() < size) { ++m_allocations; }
+
+  this->m_board.clear();
+  this->m_next.clear();
+  this->m_changed.resize(this->get_expanded_rows());
+  reserve_changed();
+  this->m_board.reserve(size);
+  this->m_next.reserve(size);
   for (size_t i = 0; i < this->get_expanded_rows(); ++i) {
     for (size_t j = 0; j < this->get_expanded_cols(); ++j) {
       this->m_board.emplace_back(i, j, false);
+      this->m_next.emplace_back(i, j, false);
+    }
+  }
+}
+
+/*!
+ * Empties the lists of changed cells, making room in each one for a whole row,
+ * so recording the cells that flip never allocates while stepping.
+ */
+void LifeCfg::reserve_changed() {
+  for (auto& changed : m_changed) {
+    changed.clear();
+    if (changed.capacity() < m_cols) {
+      changed.reserve(m_cols);
+      ++m_allocations;
     }
   }
 }
@@ -219,51 +279,265 @@ std::vector<string> LifeCfg::read_file_info(const std::string& filename) {
   return lines;
 }
 
+namespace {
+/// Returns the next line of a buffer, without the line break, and moves past it.
+std::string_view next_line(const char*& pos, const char* end) {
+  const auto* eol = static_cast<const char*>(std::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+  if (eol == nullptr) { eol = end; }
+
+  std::string_view line(pos, static_cast<size_t>(eol - pos));
+  pos = eol == end ? end : eol + 1;
+  return line;
+}
+
+/// Reads a non-negative integer, skipping the blanks before it, and moves past it.
+size_t parse_size(std::string_view& text) {
+  while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) { text.remove_prefix(1); }
+
+  size_t value = 0;
+  const auto [last, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+  if (error != std::errc()) { throw std::invalid_argument("Invalid grid size in the input file."); }
+
+  text.remove_prefix(static_cast<size_t>(last - text.data()));
+  return value;
+}
+}  // namespace
+
 /*!
  * Loads the board configuration from a file.
- * @param filename The name of the file to load from.
+ * The file is memory-mapped and its rows are parsed straight from the mapped
+ * bytes into the board, with no intermediate copy of the lines.
+ * The program stops if the file cannot be opened.
+ * @param ini_config The configuration, with the name of the file to load from.
  */
 void LifeCfg::load_from_file(Config& ini_config) {
-  std::vector<std::string> lines = read_file_info(ini_config.get_input_cfg());
-  size_t line_count = 0;
-  char alive_char = ' ';
+  if (!load_from_file(ini_config.get_input_cfg(), ini_config)) {
+    std::cerr << " error! " << std::endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+/*!
+ * Loads the board configuration from a pattern file.
+ * @param filename The name of the file to load from.
+ * @param ini_config The configuration, with the board size and rule for patterns.
+ * @return true if the file was opened, false otherwise.
+ */
+bool LifeCfg::load_from_file(const std::string& filename, Config& ini_config) {
+  *m_log << ">>> Trying to open input file [" << filename << "]...";
+
+  MappedFile file(filename);
+  if (!file.is_open()) { return false; }
+  *m_log << " done!" << std::endl;
   
   if(ini_config.get_max_gen() == 0) {
-    std::cout << ">>> Running the simulation until extinction/stability is reached, whichever occurs first." << std::endl;
+    *m_log << ">>> Running the simulation until extinction/stability is reached, whichever occurs first." << std::endl;
   } 
 
   if(ini_config.get_max_gen() != 0) {
-    std::cout << ">>> Running simulation up to " << ini_config.get_max_gen()
+    *m_log << ">>> Running simulation up to " << ini_config.get_max_gen()
               << " generations, or until extinction/stability is reached, whichever comes first." << std::endl;
   }
 
-  std::cout << ">>> Processing data, plase wait..." << std::endl;
+  *m_log << ">>> Processing data, plase wait..." << std::endl;
 
-  for (const auto& line : lines) {
-    /// Set number of lines and columns
-    if (line_count == 0) {
-      this->m_rows = std::stoi(line);
-      this->m_cols = std::stoi(line.substr(line.find(' ') + 1));
-      fill_board();
-      
-      std::cout << ">>> Grid size read from input file: " << m_rows 
-                << " rows by " << m_cols << " cols." << std::endl;
-    /// Set alive char in file.
-    } else if (line_count == 1) {
-      alive_char = line[0];
-      std::cout << ">>> Character that represents a living cell read from input file: ’" << alive_char << "’." << std::endl;
+  const e_pattern_format format = pattern_format(filename);
+  if (format != e_pattern_format::DAT) {
+    load_pattern(std::string_view(file.data(), file.size()), format, ini_config);
+    *m_log << ">>> Finished reading input data file." << std::endl << std::endl;
+    return true;
+  }
+
+  const char* pos = file.data();
+  const char* const end = pos + file.size();
+
+  /// Set number of lines and columns
+  if (pos < end) {
+    std::string_view header = next_line(pos, end);
+    this->m_rows = parse_size(header);
+    this->m_cols = parse_size(header);
+    fill_board();
+
+    *m_log << ">>> Grid size read from input file: " << m_rows 
+              << " rows by " << m_cols << " cols." << std::endl;
+  }
+
+  /// Set alive char in file.
+  char alive_char = ' ';
+  if (pos < end) {
+    const std::string_view line = next_line(pos, end);
+    alive_char = line.empty() ? '\0' : line.front();
+    *m_log << ">>> Character that represents a living cell read from input file: ’" << alive_char << "’." << std::endl;
+  }
+
+  /// Set configuration of board, looking only for the alive cells of each row.
+  const size_t expanded_cols = get_expanded_cols();
+  for (size_t row = 1; row <= m_rows && pos < end; ++row) {
+    const std::string_view line = next_line(pos, end);
+    const char* const first = line.data();
+    const char* const last = first + std::min(line.size(), m_cols);
+    Cell* cells = m_board.data() + row * expanded_cols + 1;
+
+    for (const char* p = first;
+         (p = static_cast<const char*>(std::memchr(p, alive_char, static_cast<size_t>(last - p)))) != nullptr; ++p) {
+      cells[p - first].set_alive();
     }
-    /// Set configuration of board.
-    else {
-      const size_t row = line_count - 1;
-      if (row > m_rows) {
-        break;
-      }
-      update_row_from_file(line, alive_char, row, m_cols);
+  }
+  *m_log << ">>> Finished reading input data file." << std::endl << std::endl;
+  return true;
+}
+
+/*!
+ * Initializes the board from a RLE or plaintext pattern. The board has the
+ * size of the pattern, unless < rows > or < cols > are set in the config;
+ * a pattern smaller than the board is centered, a larger one is cropped.
+ * @param text The pattern file.
+ * @param format Format of the pattern, RLE or CELLS.
+ * @param ini_config The configuration, with the board size.
+ */
+void LifeCfg::load_pattern(std::string_view text, e_pattern_format format, Config& ini_config) {
+  const PatternReader reader(text, format);
+  *m_log << ">>> Pattern size read from input file: " << reader.rows() << " rows by " << reader.cols() << " cols." << std::endl;
+
+  /// The rule of the pattern is used, unless the config sets one.
+  Rule rule;
+  if (!reader.rule().empty() && !Rule::parse(reader.rule(), rule)) {
+    *m_log << ">>> The rule < " << reader.rule() << " > is not supported, using B3/S23." << std::endl;
+  } else if (ini_config.get_rule().empty()) {
+    m_rule = rule;
+  } else if (!reader.rule().empty() && rule.to_string() != ini_config.get_rule()) {
+    *m_log << ">>> The rule < " << reader.rule() << " > of the pattern is replaced by < " << ini_config.get_rule() << " >." << std::endl;
+  }
+
+  this->m_rows = ini_config.get_rows() != 0 ? ini_config.get_rows() : reader.rows();
+  this->m_cols = ini_config.get_cols() != 0 ? ini_config.get_cols() : reader.cols();
+  fill_board();
+  *m_log << ">>> Grid size: " << m_rows << " rows by " << m_cols << " cols." << std::endl;
+
+  const size_t first_row = m_rows > reader.rows() ? (m_rows - reader.rows()) / 2 : 0;
+  const size_t first_col = m_cols > reader.cols() ? (m_cols - reader.cols()) / 2 : 0;
+  const size_t expanded_cols = get_expanded_cols();
+
+  reader.cells([&](size_t row, size_t col, size_t count) {
+    row += first_row;
+    col += first_col;
+    if (row >= m_rows || col >= m_cols) { return; }
+
+    Cell* cells = m_board.data() + (row + 1) * expanded_cols + 1;
+    for (size_t c = col; c < std::min(col + count, m_cols); ++c) { cells[c].set_alive(); }
+  });
+}
+
+/*!
+ * Writes the board to a pattern file: RLE for ".rle", plaintext for ".cells"
+ * and the original format for any other extension.
+ * @param filename Name of the pattern file.
+ * @return true if the file was written, false otherwise.
+ */
+bool LifeCfg::save_to_file(const std::string& filename) const {
+  switch (pattern_format(filename)) {
+    case e_pattern_format::RLE: return write_rle(*this, filename, m_rule.to_string());
+    case e_pattern_format::CELLS: return write_cells(*this, filename);
+    default: return write_dat(*this, filename);
+  }
+}
+
+/*!
+ * Initializes the board from the bit-packed board of a checkpoint, and the
+ * rule from the rule it was simulated with, unless the config sets one.
+ * @param checkpoint The checkpoint, cells in row-major order.
+ * @param ini_config The configuration, with the rule.
+ */
+void LifeCfg::load_checkpoint(const Checkpoint& checkpoint, Config& ini_config) {
+  load_packed(static_cast<size_t>(checkpoint.rows), static_cast<size_t>(checkpoint.cols), checkpoint.bits);
+  *m_log << ">>> Grid size read from checkpoint: " << m_rows << " rows by " << m_cols << " cols." << std::endl;
+
+  Rule rule;
+  if (!Rule::parse(checkpoint.rule, rule)) {
+    *m_log << ">>> The rule < " << checkpoint.rule << " > is not supported, using B3/S23." << std::endl;
+  } else if (ini_config.get_rule().empty()) {
+    m_rule = rule;
+  } else if (rule.to_string() != ini_config.get_rule()) {
+    *m_log << ">>> The rule < " << checkpoint.rule << " > of the checkpoint is replaced by < " << ini_config.get_rule() << " >." << std::endl;
+  }
+}
+
+/*!
+ * Replaces the board with the live cells of a whole plane, written by
+ * save_plane(), and shows its window.
+ * @param plane The live cells of the plane.
+ * @return true if the engine simulates a plane and loaded it, false otherwise.
+ */
+bool LifeCfg::load_plane(const std::vector<uint64_t>& plane) {
+  if (!m_engine || !m_engine->load_plane(*this, plane)) { return false; }
+  m_engine->store(*this);
+  return true;
+}
+
+/*!
+ * Initializes the board from a bit-packed board, one bit per cell in row-major order.
+ * @param rows Number of rows of the board.
+ * @param cols Number of columns of the board.
+ * @param packed The bit-packed board.
+ */
+void LifeCfg::load_packed(size_t rows, size_t cols, const std::vector<uint64_t>& packed) {
+  this->m_rows = rows;
+  this->m_cols = cols;
+  fill_board();
+
+  const size_t expanded_cols = get_expanded_cols();
+  for (size_t word = 0; word < packed.size(); ++word) {
+    for (uint64_t bits = packed[word]; bits != 0; bits &= bits - 1) {
+      const size_t index = word * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+      if (index >= m_rows * m_cols) { break; }
+      m_board[(index / m_cols + 1) * expanded_cols + index % m_cols + 1].is_alive = true;
+    }
+  }
+}
+
+/*!
+ * Packs the board, one bit per cell in row-major order, as read by load_packed().
+ * @param packed Receives the bit-packed board.
+ */
+void LifeCfg::pack(std::vector<uint64_t>& packed) const {
+  size_t index = 0;
+  packed.assign((m_rows * m_cols + 63) / 64, 0);
+  for (size_t r = 1; r <= m_rows; ++r) {
+    for (size_t c = 1; c <= m_cols; ++c, ++index) {
+      if (get_cell(r, c).is_alive) { packed[index / 64] |= uint64_t{ 1 } << (index % 64); }
     }
-    ++line_count;
   }
-  std::cout << ">>> Finished reading input data file." << std::endl << std::endl;
+}
+
+/*!
+ * Writes past generations kept by a stability detector as RLE files of a
+ * directory, named after their generations.
+ * @param detector The detector, with the history of the observed boards.
+ * @param first First generation written.
+ * @param dir The directory, created if needed.
+ * @return Number of generations written.
+ */
+size_t LifeCfg::dump_history(const StabilityDetector& detector, size_t first, const std::string& dir) const {
+  std::error_code error;
+  std::filesystem::create_directories(dir, error);
+
+  std::ostream silent(nullptr);
+  LifeCfg past(m_rows, m_cols);
+  past.set_log(silent);
+  past.m_rule = m_rule;
+  size_t written = 0;
+
+  const HistoryStore& history = detector.history();
+  history.for_each(history.first(), history.size(), [&](size_t index, const HistoryStore::board_t& board) {
+    const size_t generation = detector.generations()[index];
+    if (generation < first) { return; }
+
+    std::ostringstream filename;
+    filename << dir << "/gen_" << std::setfill('0') << std::setw(5) << generation << ".rle";
+    past.load_packed(m_rows, m_cols, board);
+    if (past.save_to_file(filename.str())) { ++written; }
+  });
+  return written;
 }
 
 /*!
@@ -289,36 +563,211 @@ void LifeCfg::update_row_from_file(const std::string& line, char trigger, size_t
  * @return std::string The string representation of the board.
  */
 std::string LifeCfg::to_string() {
-  std::ostringstream oss;
+  static constexpr char alive[] = "•";  //!<- UTF-8 bullet, several bytes long.
+  std::string text;
+  text.reserve(m_rows * (m_cols * (sizeof(alive) - 1) + 3));
+
   for (size_t i = 1; i <= m_rows; ++i) {
-    oss << "[";
-    for (size_t j = 1; j <= m_cols; ++j) {
-      if (get_cell(i, j).is_alive) {
-        oss << "•";
-      } else
-        oss << " ";
+    const Cell* cells = m_board.data() + i * get_expanded_cols() + 1;
+    text += '[';
+    for (size_t j = 0; j < m_cols; ++j) {
+      if (cells[j].is_alive) {
+        text.append(alive, sizeof(alive) - 1);
+      } else {
+        text += ' ';
+      }
     }
-    oss << "]\n";
+    text += "]\n";
   }
-  return oss.str();
+  return text;
+}
+
+/*!
+ * Selects the engine used to compute the next generations.
+ * The chosen engine starts from the current board state.
+ * @param ini_config The configuration, with the engine name ("cell" for the board
+ * itself, "bitpacked", "sparse", "hashlife" or "simd") and its settings.
+ */
+void LifeCfg::set_engine(Config& ini_config) {
+  const std::string name = ini_config.get_engine();
+  const std::string topology = ini_config.get_topology();
+
+  m_topology = topology == "torus" ? e_topology::TORUS
+               : topology == "plane" ? e_topology::PLANE
+                                     : e_topology::BOUNDED;
+
+  /// The rule of the config wins over the rule of the pattern.
+  if (!ini_config.get_rule().empty()) { Rule::parse(ini_config.get_rule(), m_rule); }
+  *m_log << ">>> Rule: " << m_rule.to_string() << "." << std::endl;
+
+  /// A rule with B0 gives birth to every empty cell, which an unbounded plane cannot hold.
+  if (m_rule.born(0) && m_topology == e_topology::PLANE) {
+    *m_log << ">>> The rule < " << m_rule.to_string() << " > fills an unbounded plane." << std::endl;
+    *m_log << ">>> Using the default value [bounded]." << std::endl;
+    m_topology = e_topology::BOUNDED;
+  }
+
+  if (name == "bitpacked") {
+    m_engine = std::make_unique<BitBoard>();
+  } else if (name == "sparse") {
+    m_engine = std::make_unique<TileBoard>();
+  } else if (name == "hashlife") {
+    m_engine = std::make_unique<HashLife>(ini_config.get_node_cache());
+  } else if (name == "simd") {
+    auto board = std::make_unique<ByteBoard>();
+    if (!board->set_kernel(ini_config.get_kernel())) {
+      *m_log << ">>> The kernel < " << ini_config.get_kernel() << " > is not supported by this processor." << std::endl;
+    }
+    *m_log << ">>> Using the [" << board->kernel_name() << "] kernel." << std::endl;
+    m_engine = std::move(board);
+  } else {
+    m_engine.reset();
+  }
+
+  /// The cell engine knows bounded and toroidal boards; bitpacked knows every topology and rule.
+  if (m_engine ? !m_engine->set_topology(m_topology) : m_topology == e_topology::PLANE) {
+    *m_log << ">>> The < " << topology << " > topology is not supported by the < " << name << " > engine." << std::endl;
+    *m_log << ">>> Using the [bitpacked] engine." << std::endl;
+    m_engine = std::make_unique<BitBoard>();
+    m_engine->set_topology(m_topology);
+  }
+  if (m_engine && !m_engine->set_rule(m_rule)) {
+    *m_log << ">>> The rule < " << m_rule.to_string() << " > is not supported by the < " << name << " > engine." << std::endl;
+    *m_log << ">>> Using the [bitpacked] engine." << std::endl;
+    m_engine = std::make_unique<BitBoard>();
+    m_engine->set_topology(m_topology);
+    m_engine->set_rule(m_rule);
+  }
+  if (!m_engine) { return; }
+
+  m_engine->set_thread_pool(m_pool.get());
+  m_engine->load(*this);
+}
+
+/*!
+ * Sets how many threads compute each generation, in bands of rows.
+ * The threads are started here and reused by every generation.
+ * @param n_threads Number of threads; 1 steps the board serially.
+ */
+void LifeCfg::set_threads(size_t n_threads) {
+  if (n_threads <= 1) {
+    m_pool.reset();
+  } else {
+    m_pool = std::make_unique<ThreadPool>(n_threads);
+  }
+  if (m_engine) { m_engine->set_thread_pool(m_pool.get()); }
 }
 
 /*!
  * Updates the board to the next generation according to the rules of the game.
+ * The generation is computed into the second buffer, which then becomes the
+ * current board, so no memory is allocated while stepping.
  */
 void LifeCfg::update() {
-  auto previous_cfg = LifeCfg(*this);
+  ++m_updates;
+
+  /// Let the selected engine compute the generation, it records the changes as it stores them.
+  if (m_engine) {
+    for (auto& changed : m_changed) { changed.clear(); }
+    m_engine->step();
+    m_engine->store(*this);
+    return;
+  }
 
-  for (int i = 1; i <= this->m_rows; ++i) {
-    for (int j = 1; j <= this->m_cols; ++j) {
-      Cell& new_cell = get_cell(i, j);
-      const Cell& past_cell = previous_cfg.get_cell(i,j);
-      size_t alive_neighbors = previous_cfg.get_alive_neighbor_count(past_cell);
-      
-      if (alive_neighbors <= 1 or alive_neighbors >= 4) { new_cell.set_dead(); }
-      else if (!past_cell.is_alive and alive_neighbors == 3) { new_cell.set_alive(); }
+  /// On a torus the ghost border holds the opposite edges while updating.
+  if (m_topology == e_topology::TORUS) { wrap_border(true); }
+
+  /// Split the rows in bands among the threads, if there are any, with the kernel of the rule.
+  with_rule(m_rule, [this](const auto& rule) {
+    if (m_pool) {
+      m_pool->for_each_band(1, m_rows + 1, [this, &rule](size_t first, size_t last) {
+        update_rows(first, last, rule);
+      });
+    } else {
+      update_rows(1, m_rows + 1, rule);
     }
+  });
+
+  if (m_topology == e_topology::TORUS) { wrap_border(false); }
+  m_board.swap(m_next);
+}
+
+/*!
+ * Copies the opposite edges of the board into its ghost border, so the
+ * neighbors read across an edge are the ones of a torus, or kills the
+ * ghost border again, as every other member expects it dead.
+ * @param wrap true to copy the opposite edges, false to kill the border.
+ */
+void LifeCfg::wrap_border(bool wrap) {
+  for (size_t r = 1; r <= m_rows; ++r) {
+    get_cell(r, 0).is_alive = wrap && get_cell(r, m_cols).is_alive;
+    get_cell(r, m_cols + 1).is_alive = wrap && get_cell(r, 1).is_alive;
+  }
+  /// Whole rows, after the columns, so the corners are wrapped too.
+  for (size_t c = 0; c <= m_cols + 1; ++c) {
+    get_cell(0, c).is_alive = wrap && get_cell(m_rows, c).is_alive;
+    get_cell(m_rows + 1, c).is_alive = wrap && get_cell(1, c).is_alive;
+  }
+}
+
+/*!
+ * Computes the next generation of the rows in [first, last) into the second buffer.
+ * Only the current board is read, so bands of rows are independent.
+ * @param first First row to be updated.
+ * @param last One past the last row to be updated.
+ * @param rule Kernel rule: B3/S23 is tested directly, any other rule is looked up in its table.
+ */
+template <typename KernelRule>
+void LifeCfg::update_rows(size_t first, size_t last, const KernelRule& rule) {
+  const size_t expanded_cols = get_expanded_cols();
+
+  for (size_t i = first; i < last; ++i) {
+    auto& changed = m_changed[i];  //!<- Each band only touches the lists of its own rows.
+    changed.clear();
+
+    for (size_t j = 1; j <= this->m_cols; ++j) {
+      const Cell& past_cell = get_cell(i, j);
+      Cell& new_cell = m_next[i * expanded_cols + j];
+      size_t alive_neighbors = get_alive_neighbor_count(past_cell);
+
+      if constexpr (std::is_same_v<KernelRule, ConwayRule>) {
+        if (alive_neighbors <= 1 or alive_neighbors >= 4) { new_cell.set_dead(); }
+        else if (alive_neighbors == 3) { new_cell.set_alive(); }
+        else { new_cell.is_alive = past_cell.is_alive; }
+      } else {
+        new_cell.is_alive = rule.table.next[past_cell.is_alive][alive_neighbors] != 0;
+      }
+
+      if (new_cell.is_alive != past_cell.is_alive) { changed.push_back(static_cast<uint32_t>(j)); }
+    }
+  }
+}
+
+/*!
+ * Advances the board by a number of generations at once.
+ * Engines that can jump ahead (such as HashLife) skip the intermediate generations.
+ * @param generations Number of generations to advance.
+ */
+void LifeCfg::fast_forward(size_t generations) {
+  if (m_engine) {
+    m_updates += generations;
+    for (auto& changed : m_changed) { changed.clear(); }
+    m_engine->advance(generations);
+    m_engine->store(*this);
+    return;
   }
+
+  for (size_t i = 0; i < generations; ++i) { update(); }
+}
+
+/*!
+ * Counts the alive cells; the engine knows how many cells are alive.
+ * @return The number of alive cells.
+ */
+size_t LifeCfg::population() const {
+  if (m_engine) { return m_engine->population(); }
+
+  return static_cast<size_t>(std::count_if(m_board.begin(), m_board.end(), [](const Cell& cell) { return cell.is_alive; }));
 }
 
 /*!
@@ -326,6 +775,9 @@ void LifeCfg::update() {
  * @return true if there are no live cells, false otherwise.
  */
 bool LifeCfg::extinct() const {
+  /// The engine knows how many cells are alive.
+  if (m_engine) { return m_engine->population() == 0; }
+
   for (const auto& cell : m_board) {
     if (cell.is_alive) { return false; }
   }
@@ -351,59 +803,212 @@ bool LifeCfg::stable(const std::vector<LifeCfg>& previous_configs) const {
 /*!
  * Runs the simulation for a given number of generations or until extinction/stability.
  * @param ini_config An object with all options of configurations of the simulation.
+ * @param resume Checkpoint already loaded into the board, or nullptr to start a new simulation.
  */
-void LifeCfg::generation_loop(Config& ini_config) {
+void LifeCfg::generation_loop(Config& ini_config, Checkpoint* resume) {
 
   print_game_of_life_intro();
-
-  std::vector<LifeCfg> history;   //!<- Vector with all history of generations.
+  set_threads(ini_config.get_threads());
+  set_engine(ini_config);
+
+  StabilityDetector detector;     //!<- Hashes of all generations already simulated.
+  std::unique_ptr<ImageWriter> writer;  //!<- Encoder threads, when images are generated.
+  std::unique_ptr<CheckpointWriter> checkpoints;  //!<- Thread that saves the checkpoints, when enabled.
+  std::unique_ptr<StatsRecorder> stats;  //!<- Statistics of each generation, when enabled.
+  std::unique_ptr<TerminalRenderer> terminal;  //!<- Draws the generations in place, when enabled.
+  std::unique_ptr<FramePacer> pacer;  //!<- Schedules the frames of the text output.
+  double step_ms = 0;             //!<- Time spent computing the current generation.
+  size_t checkpoint_every = ini_config.get_checkpoint_every();
+  size_t checkpoint_sent = 0;     //!<- Observed boards already handed to the checkpoint writer.
   int max_gen;
   int generation = 1;
-  int frame_duration = 1000 / ini_config.get_fps();
+
+  detector.set_history(ini_config.get_history_keyframe(), ini_config.get_history_memory() << 20);
+
+  /// Continue from a checkpoint, with the generations it had already observed.
+  std::vector<uint64_t> key;  //!<- Whether the engine simulates a plane, and keys it can resume.
+  const bool plane = plane_key(key);
+  if (resume) {
+    generation = static_cast<int>(resume->generation);
+    /// The window is only part of a plane: the whole plane goes on, or nothing does.
+    if (!resume->plane.empty() && !load_plane(resume->plane)) {
+      std::cout << ">>> The checkpoint holds an unbounded plane, which the < " << ini_config.get_engine()
+                << " > engine on a < " << ini_config.get_topology() << " > board cannot continue." << std::endl;
+      return;
+    }
+    if (resume->plane_keys && !portable_plane_key()) {
+      std::cout << ">>> The stability history of the checkpoint cannot be compared by the < " << ini_config.get_engine()
+                << " > engine; it starts over." << std::endl;
+    } else {
+      detector.restore(m_rows, m_cols,
+                       std::vector<size_t>(resume->history_generations.begin(), resume->history_generations.end()),
+                       std::move(resume->history_hashes), std::move(resume->history), resume->plane_keys);
+    }
+    std::cout << ">>> Resuming the simulation at generation " << generation << "." << std::endl;
+  } else if (ini_config.get_jump_to() > 1) {
+    /// Skip to the requested first generation.
+    std::cout << ">>> Advancing to generation " << ini_config.get_jump_to() << "..." << std::endl;
+    fast_forward(ini_config.get_jump_to() - 1);
+    generation = ini_config.get_jump_to();
+  }
+
+  if (checkpoint_every > 0) {
+    checkpoints = std::make_unique<CheckpointWriter>(ini_config.get_checkpoint_file());
+    if (plane && !portable_plane_key()) {
+      std::cout << ">>> The < " << ini_config.get_engine() << " > engine keeps no stability history in the checkpoints:"
+                << " a resumed run only compares the generations after its checkpoint." << std::endl;
+    }
+  }
+
+  /// The plain text output prints whole boards; the renderer draws in place, packed glyphs or a viewport.
+  const bool plain_text = ini_config.get_text_mode() == "scroll" && ini_config.get_glyph() == "bullet"
+                          && ini_config.get_zoom() == 1 && ini_config.get_view_row() <= 1 && ini_config.get_view_col() <= 1
+                          && ini_config.get_view_rows() == 0 && ini_config.get_view_cols() == 0;
+  if (!ini_config.get_generate_image() && !plain_text) {
+    terminal = std::make_unique<TerminalRenderer>(m_rows, m_cols, ini_config, STDOUT_FILENO);
+  }
+
+  /// The text output is paced at the fps of the config; images are generated as fast as they can.
+  if (!ini_config.get_generate_image()) {
+    pacer = std::make_unique<FramePacer>(ini_config.get_fps(), ini_config.get_drop_frames());
+  }
+
+  if (!ini_config.get_stats_file().empty()) {
+    stats = std::make_unique<StatsRecorder>(ini_config.get_stats_capacity());
+  }
+
+  if (ini_config.get_generate_image()) {
+    writer = std::make_unique<ImageWriter>(ini_config, ini_config.get_encoders(), ini_config.get_queue_size());
+    if (ini_config.get_output() == "raw") {
+      std::cout << ">>> Raw RGBA frames of " << m_cols * ini_config.get_block_size() << "x"
+                << m_rows * ini_config.get_block_size() << " pixels written to [" << writer->destination() << "]."
+                << std::endl;
+    }
+  }
 
   /// Set the max generation.
-  if (ini_config.get_max_gen() == 0) { max_gen = 99999; } 
+  if (ini_config.get_max_gen() == 0) { max_gen = generation + 99998; } 
   else { max_gen = ini_config.get_max_gen(); }
   
+  const int first_generation = generation;  //!<- Checkpoints are counted from here.
   while (generation <= max_gen) {
+    if (stats) { stats->record(*this, generation, step_ms); }
+
     /// Check stop conditions.
     if (this->extinct()) { 
       std::cout << "\n>>> Extinct configuration. ";
       break; 
     }
-    if (this->stable(history)) { 
-      auto it = std::find(history.begin(), history.end(), *this);  //<- Find element.
-      int index = std::distance(history.begin(), it);
-      int frequency = generation - index - 2; 
+    /// Hand the board and the history observed since the last checkpoint to the checkpoint thread.
+    /// It is taken before observing the board, which is observed again on resume.
+    if (checkpoints && generation != first_generation && (generation - first_generation) % checkpoint_every == 0) {
+      Checkpoint checkpoint;
+
+      checkpoint.generation = static_cast<uint64_t>(generation);
+      checkpoint.rows = m_rows;
+      checkpoint.cols = m_cols;
+      pack(checkpoint.bits);
+      checkpoint.rule = m_rule.to_string();
+      /// The window is only part of a plane, which is saved whole.
+      save_plane(checkpoint.plane);
+      /// Plane keys are only saved when another run can compare them.
+      if (!detector.plane() || portable_plane_key()) {
+        checkpoint.plane_keys = detector.plane();
+        if (checkpoint_sent > detector.size()) { checkpoint_sent = 0; }
+        checkpoint.history_begin = checkpoint_sent;
+        checkpoint.history_generations.assign(detector.generations().begin() + checkpoint_sent, detector.generations().end());
+        checkpoint.history_hashes.assign(detector.hashes().begin() + checkpoint_sent, detector.hashes().end());
+        checkpoint.history_kept = detector.history().first();
+        /// The segment of the last board sent may have grown since.
+        detector.history().copy_tail(checkpoint_sent == 0 ? 0 : checkpoint_sent - 1, checkpoint.history);
+        checkpoint_sent = detector.size();
+      }
+      checkpoints->submit(std::move(checkpoint));
+    }
+
+    if (detector.observe(*this, generation)) { 
+      int first = detector.first_generation();  //<- Generation where the board first appeared.
+      int frequency = generation - first - 1; 
+
+      std::cout << "\nStable configuration starting at generation " << first << " with frequency = " << frequency << ". ";
 
-      std::cout << "\nStable configuration starting at generation " << index + 1 << " with frequency = " << frequency << ". ";
+      /// Write the past generations, rebuilt from the history of the detector.
+      if (!ini_config.get_history_dump().empty() && detector.plane()) {
+        std::cout << "\n>>> The past generations of an unbounded plane are not kept as boards, none saved. ";
+      } else if (!ini_config.get_history_dump().empty()) {
+        const size_t dumped = dump_history(detector, ini_config.get_history_dump_all() ? 0 : first, ini_config.get_history_dump());
+        std::cout << "\n>>> " << dumped << " generations saved in [" << ini_config.get_history_dump() << "]. ";
+      }
       break; 
     }
-    
+
     /// Display or generate an image of each generation of the simulation.
-    if(ini_config.get_generate_image()) {
+    if(writer) {
       
       std::cout << "Generation " << generation << ":" << std::endl;
-      
-      Canvas image(m_cols, m_rows, ini_config.get_block_size());  //!< The image set a canvas.  
-      set_img(image, ini_config);  //!< Update the configuration in image.
+      writer->push(*this, generation);  //!< The image is drawn and saved by the encoder threads.
+
+    } else if (pacer->begin_frame()) {
+      if (terminal) {
+        terminal->draw(*this, generation);
+      } else {
+        std::cout << "Generation " << generation << ":" << std::endl;
+        std::cout << this->to_string();
+      }
+    }
+    
+    /// Update data.
+    if (stats) {
+      auto start = std::chrono::steady_clock::now();
+      this->update();
+      step_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    } else {
+      this->update();
+    }
+    generation++;
+    if (pacer) { pacer->end_frame(); }
+  }
 
-      std::string filename = generate_filename(ini_config.get_path(), generation);
-      bool sucess = encode_png(filename, image.pixels(), image.width(), image.height());  //!< Indicate if the image generation was a sucessfuly.
+  /// Report the frame rate of the text output.
+  if (pacer) {
+    std::cout << "\n>>> " << pacer->drawn() << " frames shown at " << std::fixed << std::setprecision(1)
+              << pacer->achieved_fps() << " fps (target " << pacer->target_fps() << " fps), " << pacer->dropped()
+              << " dropped. " << std::defaultfloat;
+  }
+
+  /// Wait for the images still in the queue.
+  if (writer) {
+    writer->finish();
+    std::cout << "\n>>> " << writer->saved() << " images saved in [" << writer->destination() << "] ("
+              << std::fixed << std::setprecision(0) << writer->bytes_per_frame() << " bytes/frame, "
+              << std::setprecision(2) << writer->ms_per_frame() << " ms/frame). " << std::defaultfloat;
+    for (const auto& filename : writer->failed()) { std::cout << "\nFailed to save image: " << filename; }
+    if (!writer->failed().empty()) { std::cout << std::endl; }
+  }
 
-      if(sucess) { std::cout << "Image saved successfully: " << filename << std::endl; }
-      if(!sucess) { std::cout << "Failed to save image: " << filename << std::endl; }
+  /// Wait for the last checkpoint.
+  if (checkpoints) {
+    checkpoints->finish();
+    std::cout << "\n>>> " << checkpoints->written() << " checkpoints saved in [" << checkpoints->filename() << "]. ";
+    if (checkpoints->failed() > 0) { std::cout << "\nFailed to save " << checkpoints->failed() << " checkpoints. "; }
+  }
 
+  /// Write the statistics of the generations simulated.
+  if (stats) {
+    if (stats->save(ini_config.get_stats_file())) {
+      std::cout << "\n>>> Statistics of " << stats->size() << " generations saved in [" << ini_config.get_stats_file() << "]. ";
     } else {
-      std::cout << "Generation " << generation << ":" << std::endl;
-      std::cout << this->to_string();
-      std::this_thread::sleep_for(std::chrono::milliseconds(frame_duration));
+      std::cout << "\n>>> Failed to save the statistics in [" << ini_config.get_stats_file() << "]. ";
+    }
+  }
+
+  /// Save the last generation reached, to resume it later or open it in other programs.
+  if (!ini_config.get_output_cfg().empty()) {
+    if (save_to_file(ini_config.get_output_cfg())) {
+      std::cout << "\n>>> Generation " << generation << " saved in [" << ini_config.get_output_cfg() << "]. ";
+    } else {
+      std::cout << "\n>>> Failed to save generation " << generation << " in [" << ini_config.get_output_cfg() << "]. ";
     }
-    
-    /// Update data.
-    history.push_back(*this);
-    this->update();
-    generation++;
   }
 
   std::cout << "Finish simulation!" << std::endl;
@@ -26,6 +26,8 @@
 #include <thread>  
 #include <chrono>  
 #include <filesystem>
+#include <memory>
+#include <string_view>
 
 using std::cerr;
 using std::cout;
@@ -37,6 +39,12 @@ using std::vector;
 #include "canvas.h"
 #include "lodepng.h"
 #include "config.h"
+#include "engine.h"
+#include "stability.h"
+#include "thread_pool.h"
+#include "image_writer.h"
+#include "pattern_io.h"
+#include "checkpoint.h"
 
 namespace life {
 
@@ -99,43 +107,109 @@ public:
   /// Sets the image pixels based on the board's current state.
   void set_img(Canvas& img, Config& conf);
   /// Generates a filename for saving an image based on the generation number.
-  std::string generate_filename(const std::string& dir, int generation);
+  static std::string generate_filename(const std::string& dir, int generation);
   /// Encodes an image in PNG format and saves it to a file.
-  bool encode_png(const std::string& filename, const unsigned char* image, unsigned width, unsigned height);
+  static bool encode_png(const std::string& filename, const unsigned char* image, unsigned width, unsigned height);
 
   //=== Attribute accessors members.
   /// Number of columns with expanded borders
   [[nodiscard]] size_t get_expanded_cols() const { return m_cols + 2; }
   /// Number of rows with expanded borders
   [[nodiscard]] size_t get_expanded_rows() const { return m_rows + 2; }
+  /// Number of times the buffers touched while stepping were (re)allocated.
+  [[nodiscard]] size_t allocation_count() const { return m_allocations; }
   /// Returns a reference to a cell stored in the board.
   Cell& get_cell(const size_t& r, const size_t& c);
+  /// Returns a read-only reference to a cell stored in the board.
+  const Cell& get_cell(const size_t& r, const size_t& c) const;
   /// Returns a reference to a cell in the board in a position relative to another.
   Cell& get_neighbor(const Cell& cell, const e_cell_neighbor& orientation);
   /// Counts the number of alive neighbors for a given cell.
   size_t get_alive_neighbor_count(const Cell& cell);
+  /// Sets whether a cell is alive, recording it as changed if it flips.
+  void set_alive(size_t r, size_t c, bool alive);
+  /// Columns of the cells of a row that may have changed in the last update.
+  [[nodiscard]] const std::vector<uint32_t>& changed_cells(size_t r) const { return m_changed[r]; }
+  /// Number of generations computed so far, tells whether changed_cells() covers a single one.
+  [[nodiscard]] size_t update_count() const { return m_updates; }
 
   //=== Members
   /// Equality operator for comparing two LifeCfg objects.
   bool operator==(const LifeCfg&) const;
-  /// Fills the entire board with dead cells, uses expanded board values
+  /// Fills both board buffers with dead cells, uses expanded board values
   void fill_board();
   /// Returns a vector with all lines from a base file
   static std::vector<std::string> read_file_info(const std::string& filename);
-  /// Initializes the board configuration from a base file.
+  /// Initializes the board configuration from the input file of the config, stopping if it cannot be opened.
   void load_from_file(Config& ini_config);
+  /// Initializes the board configuration from a pattern file, telling whether it could be opened.
+  bool load_from_file(const std::string& filename, Config& ini_config);
+  /// Writes the board to a pattern file, in the format given by its extension.
+  bool save_to_file(const std::string& filename) const;
+  /// Initializes the board and the rule from a checkpoint.
+  void load_checkpoint(const Checkpoint& checkpoint, Config& ini_config);
+  /// Initializes the board from a bit-packed board.
+  void load_packed(size_t rows, size_t cols, const std::vector<uint64_t>& packed);
+  /// Packs the board, one bit per cell in row-major order.
+  void pack(std::vector<uint64_t>& packed) const;
   /// Updates a row on the board based on file info.
   void update_row_from_file(const std::string& line, char trigger, size_t row, size_t max_cols);
   /// Converts the current board state to a string representation.
   [[nodiscard]] std::string to_string();
+  /// Selects the engine used to compute the next generations.
+  void set_engine(Config& ini_config);
+  /// Rule of the simulation.
+  [[nodiscard]] const Rule& rule() const { return m_rule; }
+  /// Sets the stream that receives the loading messages, such as a silent one for batches.
+  void set_log(std::ostream& log) { m_log = &log; }
+  /// Describes the whole plane of the engine for the stability detector, returning false if the board is the whole simulation.
+  bool plane_key(std::vector<uint64_t>& key) const { return m_engine && m_engine->plane_key(key); }
+  /// Tells whether the plane keys of the engine can be compared with the keys of another run.
+  [[nodiscard]] bool portable_plane_key() const { return m_engine && m_engine->portable_plane_key(); }
+  /// Writes the live cells of the whole plane of the engine, returning false if the board is the whole simulation.
+  bool save_plane(std::vector<uint64_t>& plane) const { return m_engine && m_engine->save_plane(plane); }
+  /// Replaces the board with the live cells of a whole plane, returning false if the engine has no plane.
+  bool load_plane(const std::vector<uint64_t>& plane);
+  /// Whether an engine computes the generations, and so counts the alive cells itself.
+  [[nodiscard]] bool has_engine() const { return m_engine != nullptr; }
+  /// Counts the alive cells (in the whole plane, for the engines that simulate one).
+  [[nodiscard]] size_t population() const;
+  /// Sets how many threads compute each generation.
+  void set_threads(size_t n_threads);
   /// Updates the board to the next generation according to the rules of the game.
   void update();
+  /// Advances the board by a number of generations at once.
+  void fast_forward(size_t generations);
   /// Checks if the current board configuration is extinct (no live cells).
   bool extinct() const;
   /// Checks if the current board configuration is stable (matches any previous configurations).
   bool stable(const std::vector<LifeCfg>& previous_config) const;
   /// Runs the simulation for a given number of generations or until extinction/stability.
-  void generation_loop(Config& ini_config);
+  void generation_loop(Config& ini_config, Checkpoint* resume = nullptr);
+
+private:
+  /// Initializes the board from a RLE or plaintext pattern.
+  void load_pattern(std::string_view text, e_pattern_format format, Config& ini_config);
+  /// Computes the next generation of the rows in [first, last) into m_next, with a kernel rule.
+  template <typename KernelRule>
+  void update_rows(size_t first, size_t last, const KernelRule& rule);
+  /// Writes the past generations kept by a stability detector, from a generation on, as RLE files.
+  size_t dump_history(const StabilityDetector& detector, size_t first, const std::string& dir) const;
+  /// Copies the opposite edges into the ghost border (torus), or kills it again.
+  void wrap_border(bool wrap);
+  /// Empties the lists of changed cells, with room for a whole row in each.
+  void reserve_changed();
+
+  vector<Cell> m_next;      //!< Buffer where the next generation is computed.
+  size_t m_allocations{ 0 }; //!< Number of times the buffers touched while stepping were (re)allocated.
+  vector<vector<uint32_t>> m_changed; //!< Columns of the cells changed by the last update, per row.
+  size_t m_updates{ 0 };    //!< Number of generations computed so far.
+
+  std::unique_ptr<ThreadPool> m_pool; //!< Threads that step bands of rows, none for serial stepping.
+  std::unique_ptr<Engine> m_engine; //!< Alternative stepping engine, none for the cell engine.
+  e_topology m_topology{ e_topology::BOUNDED }; //!< What lies beyond the edges of the board.
+  Rule m_rule;              //!< Rule of the simulation, B3/S23 by default.
+  std::ostream* m_log{ &std::cout }; //!< Stream that receives the loading messages.
 };
 
 }  // namespace life
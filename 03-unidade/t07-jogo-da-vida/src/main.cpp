@@ -20,25 +20,99 @@
 
 #include <cstdlib>  // EXIT_SUCCESS
 #include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
 
 #include "life.h"
+#include "batch.h"
 
 using namespace life;
 
+namespace {
+/// Sends what is written to a stream into another buffer while it lives.
+class StreamRedirect {
+public:
+    /// Constructor, redirects the stream.
+    StreamRedirect(std::ostream& stream, std::streambuf* target) : m_stream(stream), m_previous(stream.rdbuf(target)) {}
+    /// Destructor, gives the stream its buffer back.
+    ~StreamRedirect() { m_stream.rdbuf(m_previous); }
+    StreamRedirect(const StreamRedirect&) = delete;
+    StreamRedirect& operator=(const StreamRedirect&) = delete;
+
+private:
+    std::ostream& m_stream;      //!< The redirected stream.
+    std::streambuf* m_previous;  //!< Buffer of the stream before the redirection.
+};
+}  // namespace
+
 int main(int argc, char* argv[]) {
-    if (argc < 2) {
+    std::string settings;  //!<- Configuration file.
+    std::string resume;    //!<- Checkpoint to continue from, if any.
+    std::string batch;     //!<- Directory or list of patterns to simulate in a batch, if any.
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--resume" && i + 1 < argc) { resume = argv[++i]; }
+        else if (arg == "--batch" && i + 1 < argc) { batch = argv[++i]; }
+        else if (settings.empty() && arg != "--resume" && arg != "--batch") { settings = arg; }
+    }
+
+    if (settings.empty()) {
         std::cerr << "Missing path to configuration file!" << std::endl;
-        std::cerr << "  Usage: glife setting.ini" << std::endl;
+        std::cerr << "  Usage: glife setting.ini [--resume checkpoint | --batch patterns]" << std::endl;
         return EXIT_FAILURE;
     }
 
+    /// The messages of the configuration are held until it tells where they may go.
     Config conf;
-    conf.load(argv[1]);
+    std::ostringstream messages;
+    try {
+        StreamRedirect held(std::cout, messages.rdbuf());
+        conf.load(settings);
+    } catch (...) {
+        std::cout << messages.str();
+        throw;
+    }
+
+    /// The raw frames may go to the standard output, so the messages go to the error output.
+    std::optional<StreamRedirect> to_stderr;
+    if (conf.get_generate_image() && conf.get_output() == "raw" && conf.get_raw_target() == "-") {
+        to_stderr.emplace(std::cout, std::cerr.rdbuf());
+    }
+    std::cout << messages.str() << std::flush;
+
+    /// Simulate every pattern of a directory (or list) and summarize them.
+    if (!batch.empty()) {
+        const auto patterns = Batch::list_patterns(batch);
+        if (patterns.empty()) {
+            std::cerr << "No pattern found in [" << batch << "]!" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        Batch runner(conf);
+        if (!Batch::write_csv(runner.run(patterns), conf.get_batch_summary(), conf.get_curve_points())) {
+            std::cerr << "Failed to write the summary [" << conf.get_batch_summary() << "]!" << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << ">>> Summary saved in [" << conf.get_batch_summary() << "]." << std::endl;
+        return EXIT_SUCCESS;
+    }
 
     LifeCfg cfg;
-    cfg.load_from_file(conf);  
+    if (resume.empty()) {
+        cfg.load_from_file(conf);  
+        cfg.generation_loop(conf);
+        return EXIT_SUCCESS;
+    }
 
-    cfg.generation_loop(conf);
+    Checkpoint checkpoint;
+    if (!checkpoint.load(resume)) {
+        std::cerr << "Failed to read checkpoint [" << resume << "]!" << std::endl;
+        return EXIT_FAILURE;
+    }
+    cfg.load_checkpoint(checkpoint, conf);
+    cfg.generation_loop(conf, &checkpoint);
 
     return EXIT_SUCCESS;
 }
\ No newline at end of file
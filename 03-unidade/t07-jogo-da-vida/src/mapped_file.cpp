@@ -0,0 +1,66 @@
+/*!
+ * MappedFile class implementation.
+ * @file mapped_file.cpp
+ */
+
+#include "mapped_file.h"
+
+#include <fstream>
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+# define LIFE_HAS_MMAP 1
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+namespace life {
+
+/*!
+ * Maps the whole file in memory, or reads it if it cannot be mapped.
+ * @param filename Name of the file.
+ */
+MappedFile::MappedFile(const std::string& filename) {
+#ifdef LIFE_HAS_MMAP
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) { return; }
+
+  struct stat info {};
+  const bool regular = ::fstat(fd, &info) == 0 && S_ISREG(info.st_mode);
+  if (regular && info.st_size > 0) {
+    void* address = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (address != MAP_FAILED) {
+      /// The file is read once, from the beginning to the end.
+      ::madvise(address, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+      m_data = static_cast<const char*>(address);
+      m_size = static_cast<size_t>(info.st_size);
+      m_mapped = true;
+    }
+  }
+  ::close(fd);
+
+  if (m_mapped || (regular && info.st_size == 0)) {
+    m_open = true;
+    return;
+  }
+#endif
+
+  /// Pipes and other special files: read the contents instead.
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.is_open()) { return; }
+  m_buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  m_data = m_buffer.data();
+  m_size = m_buffer.size();
+  m_open = true;
+}
+
+/// Destructor, unmaps the file.
+MappedFile::~MappedFile() {
+#ifdef LIFE_HAS_MMAP
+  if (m_mapped) { ::munmap(const_cast<char*>(m_data), m_size); }
+#endif
+}
+
+}  // namespace life
@@ -0,0 +1,47 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace life {
+
+/*!
+ * Read-only view of the whole contents of a file.
+ *
+ * On POSIX systems the file is memory-mapped, so its bytes are parsed
+ * straight from the page cache without being copied into strings. Where
+ * `mmap` is not available the file is read into a buffer instead.
+ */
+class MappedFile {
+public:
+  //=== Special members
+  /// Constructor, maps the file.
+  explicit MappedFile(const std::string& filename);
+  /// Destructor, unmaps the file.
+  ~MappedFile();
+  /// A mapping cannot be copied.
+  MappedFile(const MappedFile&) = delete;
+  /// A mapping cannot be assigned.
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  //=== Attribute accessors members.
+  /// Whether the file could be opened.
+  [[nodiscard]] bool is_open() const { return m_open; }
+  /// First byte of the file.
+  [[nodiscard]] const char* data() const { return m_data; }
+  /// Size of the file in bytes.
+  [[nodiscard]] size_t size() const { return m_size; }
+
+private:
+  const char* m_data{ nullptr };  //!< Contents of the file.
+  size_t m_size{ 0 };             //!< Size of the file in bytes.
+  bool m_open{ false };           //!< Whether the file could be opened.
+  bool m_mapped{ false };         //!< Whether m_data is a memory mapping.
+  std::vector<char> m_buffer;     //!< Contents of the file, when it is not mapped.
+};
+
+}  // namespace life
+
+#endif  // MAPPED_FILE_H
@@ -0,0 +1,264 @@
+/*!
+ * Pattern file readers and writers.
+ * @file pattern_io.cpp
+ */
+
+#include "pattern_io.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include "life.h"
+
+namespace life {
+
+namespace {
+/// Returns the next line of a text, without the line break (and carriage return), and moves past it.
+std::string_view next_line(std::string_view& text) {
+  const size_t eol = std::min(text.find('\n'), text.size());
+  std::string_view line = text.substr(0, eol);
+  text.remove_prefix(std::min(eol + 1, text.size()));
+  if (!line.empty() && line.back() == '\r') { line.remove_suffix(1); }
+  return line;
+}
+
+/// Removes the blanks around a text.
+std::string_view trim(std::string_view text) {
+  while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front())) != 0) { text.remove_prefix(1); }
+  while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back())) != 0) { text.remove_suffix(1); }
+  return text;
+}
+
+/// Reads a non-negative integer.
+size_t to_size(std::string_view text) {
+  text = trim(text);
+  size_t value = 0;
+  const auto [last, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+  if (error != std::errc() || last != text.data() + text.size()) {
+    throw std::invalid_argument("Invalid number < " + std::string(text) + " > in the pattern header.");
+  }
+  return value;
+}
+
+/// Appends a run to a RLE line, wrapping lines at 70 characters.
+void put_run(std::ofstream& file, size_t& line_length, size_t count, char tag) {
+  std::string run = count > 1 ? std::to_string(count) + tag : std::string(1, tag);
+  if (line_length + run.size() > 70) {
+    file << '\n';
+    line_length = 0;
+  }
+  file << run;
+  line_length += run.size();
+}
+}  // namespace
+
+/*!
+ * Guesses the format of a pattern file from its extension.
+ * @param filename Name of the pattern file.
+ * @return RLE for ".rle", CELLS for ".cells" and DAT for anything else.
+ */
+e_pattern_format pattern_format(const std::string& filename) {
+  std::string extension = std::filesystem::path(filename).extension().string();
+  std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+  if (extension == ".rle") { return e_pattern_format::RLE; }
+  if (extension == ".cells") { return e_pattern_format::CELLS; }
+  return e_pattern_format::DAT;
+}
+
+/*!
+ * Reads the header of a pattern: the size and rule of a RLE pattern, or the
+ * size of a plaintext one, which takes a pass over its lines.
+ * @throw `std::invalid_argument()` if the header of a RLE pattern is missing or invalid.
+ * @param text The pattern file.
+ * @param format Format of the pattern file, RLE or CELLS.
+ */
+PatternReader::PatternReader(std::string_view text, e_pattern_format format) : m_text(text), m_format(format) {
+  std::string_view rest = text;
+
+  if (format == e_pattern_format::RLE) {
+    /// Skip the comments, then read "x = cols, y = rows[, rule = rule]".
+    std::string_view header;
+    while (!rest.empty() && header.empty()) {
+      const std::string_view line = trim(next_line(rest));
+      if (!line.empty() && line.front() != '#') { header = line; }
+    }
+    if (header.empty()) { throw std::invalid_argument("The RLE pattern has no header."); }
+
+    while (!header.empty()) {
+      const size_t comma = std::min(header.find(','), header.size());
+      const std::string_view item = header.substr(0, comma);
+      header.remove_prefix(std::min(comma + 1, header.size()));
+
+      const size_t equal = item.find('=');
+      if (equal == std::string_view::npos) { continue; }
+      const std::string_view key = trim(item.substr(0, equal));
+      const std::string_view value = trim(item.substr(equal + 1));
+
+      if (key == "x") { m_cols = to_size(value); }
+      else if (key == "y") { m_rows = to_size(value); }
+      else if (key == "rule") { m_rule = std::string(value); }
+    }
+    m_body = rest;
+    return;
+  }
+
+  /// Plaintext: the size is the number of lines and the longest line, after the comments.
+  while (!rest.empty() && rest.front() == '!') { next_line(rest); }
+  m_body = rest;
+  while (!rest.empty()) {
+    m_cols = std::max(m_cols, next_line(rest).size());
+    ++m_rows;
+  }
+}
+
+/*!
+ * Reads the pattern, calling alive for every run of alive cells.
+ * @param alive Receives the row, the first column and the length of each run.
+ */
+void PatternReader::cells(const AliveRun& alive) const {
+  if (m_format == e_pattern_format::RLE) { rle_cells(alive); }
+  else { plaintext_cells(alive); }
+}
+
+/*!
+ * Reads the body of a RLE pattern: runs of `b` (dead) and `o` (alive) cells,
+ * `$` for the end of a row and `!` for the end of the pattern, each one
+ * optionally preceded by a count. Any other letter counts as alive.
+ * @param alive Receives the row, the first column and the length of each run.
+ */
+void PatternReader::rle_cells(const AliveRun& alive) const {
+  size_t row = 0;
+  size_t col = 0;
+  size_t count = 0;
+
+  for (const char c : m_body) {
+    if (c >= '0' && c <= '9') {
+      count = count * 10 + static_cast<size_t>(c - '0');
+      continue;
+    }
+
+    const size_t run = count == 0 ? 1 : count;
+    count = 0;
+    if (c == '!') { break; }
+    if (c == '$') {
+      row += run;
+      col = 0;
+    } else if (c == 'b' || c == '.') {
+      col += run;
+    } else if (std::isalpha(static_cast<unsigned char>(c)) != 0) {
+      alive(row, col, run);
+      col += run;
+    }
+  }
+}
+
+/*!
+ * Reads the lines of a plaintext pattern, where any character other than
+ * '.' or a blank is alive.
+ * @param alive Receives the row, the first column and the length of each run.
+ */
+void PatternReader::plaintext_cells(const AliveRun& alive) const {
+  std::string_view rest = m_body;
+
+  for (size_t row = 0; !rest.empty(); ++row) {
+    const std::string_view line = next_line(rest);
+    for (size_t col = 0; col < line.size();) {
+      if (line[col] == '.' || std::isspace(static_cast<unsigned char>(line[col])) != 0) {
+        ++col;
+        continue;
+      }
+      size_t last = col;
+      while (last < line.size() && line[last] != '.' && std::isspace(static_cast<unsigned char>(line[last])) == 0) { ++last; }
+      alive(row, col, last - col);
+      col = last;
+    }
+  }
+}
+
+/*!
+ * Writes a board as a RLE pattern. Dead cells at the end of a row and
+ * empty rows at the end of the board are left out, as usual in RLE.
+ * @param cfg The board.
+ * @param filename Name of the pattern file.
+ * @param rule Rule written in the header.
+ * @return true if the file was written, false otherwise.
+ */
+bool write_rle(const LifeCfg& cfg, const std::string& filename, const std::string& rule) {
+  std::ofstream file(filename);
+  if (!file.is_open()) { return false; }
+
+  file << "x = " << cfg.m_cols << ", y = " << cfg.m_rows << ", rule = " << rule << '\n';
+
+  size_t line_length = 0;   //!<- Characters in the current line of the file.
+  size_t pending_rows = 0;  //!<- Row ends not written yet.
+  for (size_t r = 1; r <= cfg.m_rows; ++r) {
+    size_t c = 1;
+    while (c <= cfg.m_cols) {
+      const bool state = cfg.get_cell(r, c).is_alive;
+      size_t last = c;
+      while (last <= cfg.m_cols && cfg.get_cell(r, last).is_alive == state) { ++last; }
+
+      /// A run of dead cells up to the end of the row is left out.
+      if (!state && last > cfg.m_cols) { break; }
+
+      if (pending_rows > 0) {
+        put_run(file, line_length, pending_rows, '$');
+        pending_rows = 0;
+      }
+      put_run(file, line_length, last - c, state ? 'o' : 'b');
+      c = last;
+    }
+    ++pending_rows;
+  }
+  file << "!\n";
+
+  return static_cast<bool>(file);
+}
+
+/*!
+ * Writes a board as a plaintext pattern, every row with the full width of the board.
+ * @param cfg The board.
+ * @param filename Name of the pattern file.
+ * @return true if the file was written, false otherwise.
+ */
+bool write_cells(const LifeCfg& cfg, const std::string& filename) {
+  std::ofstream file(filename);
+  if (!file.is_open()) { return false; }
+
+  file << "!Name: " << std::filesystem::path(filename).stem().string() << '\n';
+  std::string line(cfg.m_cols, '.');
+  for (size_t r = 1; r <= cfg.m_rows; ++r) {
+    for (size_t c = 1; c <= cfg.m_cols; ++c) { line[c - 1] = cfg.get_cell(r, c).is_alive ? 'O' : '.'; }
+    file << line << '\n';
+  }
+
+  return static_cast<bool>(file);
+}
+
+/*!
+ * Writes a board in the original format: size, alive character and the whole grid.
+ * @param cfg The board.
+ * @param filename Name of the pattern file.
+ * @param alive Character of the alive cells.
+ * @return true if the file was written, false otherwise.
+ */
+bool write_dat(const LifeCfg& cfg, const std::string& filename, char alive) {
+  std::ofstream file(filename);
+  if (!file.is_open()) { return false; }
+
+  file << cfg.m_rows << ' ' << cfg.m_cols << '\n' << alive << '\n';
+  std::string line(cfg.m_cols, '.');
+  for (size_t r = 1; r <= cfg.m_rows; ++r) {
+    for (size_t c = 1; c <= cfg.m_cols; ++c) { line[c - 1] = cfg.get_cell(r, c).is_alive ? alive : '.'; }
+    file << line << '\n';
+  }
+
+  return static_cast<bool>(file);
+}
+
+}  // namespace life
@@ -0,0 +1,75 @@
+#ifndef PATTERN_IO_H
+#define PATTERN_IO_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace life {
+
+class LifeCfg;
+
+/// Formats of pattern files.
+enum class e_pattern_format : short {
+  DAT = 0,  //!< The original format: size, alive character and the whole grid.
+  RLE,      //!< Run-length encoded format used by Golly and most pattern collections.
+  CELLS,    //!< Plaintext format: '.' for dead cells and 'O' for alive ones.
+};
+
+/// Guesses the format of a pattern file from its extension.
+e_pattern_format pattern_format(const std::string& filename);
+
+/*!
+ * Streaming reader of RLE and plaintext (.cells) patterns.
+ *
+ * The header is read on construction, so the board can be sized before the
+ * cells are read. `cells()` then walks the text once and reports the alive
+ * cells as runs, so a large RLE pattern is read in time proportional to
+ * its encoded size, not to its area.
+ */
+class PatternReader {
+public:
+  /// Receives a run of alive cells: row, first column and length, counted from zero.
+  using AliveRun = std::function<void(size_t, size_t, size_t)>;
+
+  //=== Special members
+  /// Constructor, reads the header of the pattern.
+  PatternReader(std::string_view text, e_pattern_format format);
+
+  //=== Members
+  /// Reads the pattern, calling alive for every run of alive cells.
+  void cells(const AliveRun& alive) const;
+
+  //=== Attribute accessors members.
+  /// Number of rows of the pattern.
+  [[nodiscard]] size_t rows() const { return m_rows; }
+  /// Number of columns of the pattern.
+  [[nodiscard]] size_t cols() const { return m_cols; }
+  /// Rule declared by the pattern, empty if none.
+  [[nodiscard]] const std::string& rule() const { return m_rule; }
+
+private:
+  /// Reads the body of a RLE pattern.
+  void rle_cells(const AliveRun& alive) const;
+  /// Reads the lines of a plaintext pattern.
+  void plaintext_cells(const AliveRun& alive) const;
+
+  std::string_view m_text;   //!< The pattern file.
+  e_pattern_format m_format; //!< Format of the pattern file.
+  std::string_view m_body;   //!< The cells, after the header and comments.
+  size_t m_rows{ 0 };        //!< Number of rows of the pattern.
+  size_t m_cols{ 0 };        //!< Number of columns of the pattern.
+  std::string m_rule;        //!< Rule declared by the pattern.
+};
+
+/// Writes a board as a RLE pattern.
+bool write_rle(const LifeCfg& cfg, const std::string& filename, const std::string& rule = "B3/S23");
+/// Writes a board as a plaintext pattern.
+bool write_cells(const LifeCfg& cfg, const std::string& filename);
+/// Writes a board in the original format.
+bool write_dat(const LifeCfg& cfg, const std::string& filename, char alive = '*');
+
+}  // namespace life
+
+#endif  // PATTERN_IO_H
@@ -0,0 +1,160 @@
+/*!
+ * PngEncoder class implementation.
+ * @file png_encoder.cpp
+ */
+
+#include "png_encoder.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace life {
+
+namespace {
+/// Adds a color to the palette of a color mode.
+void add_color(LodePNGColorMode& mode, const Color& color) {
+  lodepng_palette_add(&mode, color.channels[Color::R], color.channels[Color::G], color.channels[Color::B], 255);
+}
+
+/// Tells whether a cell of a bit-packed board is alive.
+inline bool is_alive(const uint64_t* bits, size_t index) { return ((bits[index / 64] >> (index % 64)) & 1U) != 0; }
+}  // namespace
+
+/*!
+ * Prepares the encoder settings.
+ * @param alive Color of alive cells.
+ * @param bkg Color of dead cells.
+ * @param block_size Pixel size of each cell.
+ * @param palette true for 1-bit palette images, false for RGBA images.
+ * @param deflate Settings of the deflate compression.
+ */
+PngEncoder::PngEncoder(const Color& alive, const Color& bkg, size_t block_size, bool palette, const Deflate& deflate)
+    : m_alive(alive), m_bkg(bkg), m_block_size(block_size), m_palette(palette) {
+  /// Every image gets the same color settings, which also keeps the frames of an animation compatible.
+  m_state.encoder.auto_convert = 0;
+  m_state.encoder.zlibsettings.windowsize = deflate.window;
+  m_state.encoder.zlibsettings.nicematch = deflate.nicematch;
+  m_state.encoder.zlibsettings.lazymatching = deflate.lazy ? 1 : 0;
+
+  if (m_palette) {
+    /// Index 0 is a dead cell and index 1 an alive one, in the image and in the input.
+    for (LodePNGColorMode* mode : { &m_state.info_png.color, &m_state.info_raw }) {
+      mode->colortype = LCT_PALETTE;
+      mode->bitdepth = 1;
+      add_color(*mode, m_bkg);
+      add_color(*mode, m_alive);
+    }
+  } else {
+    m_state.info_png.color.colortype = LCT_RGBA;
+    m_state.info_png.color.bitdepth = 8;
+  }
+}
+
+/*!
+ * Encodes the board of a frame.
+ * @param frame The frame.
+ * @param png Receives the PNG file; its memory is reused.
+ * @return true if the image was encoded, false otherwise.
+ */
+bool PngEncoder::encode(const Frame& frame, std::vector<unsigned char>& png) {
+  const auto width = static_cast<unsigned>(frame.cols * m_block_size);
+  const auto height = static_cast<unsigned>(frame.rows * m_block_size);
+  png.clear();
+
+  if (m_palette) {
+    render_indices(frame);
+    return lodepng::encode(png, m_indices.data(), width, height, m_state) == 0U;
+  }
+
+  return lodepng::encode(png, render_rgba(frame).pixels(), width, height, m_state) == 0U;
+}
+
+/*!
+ * Redraws the cells that differ from the last frame drawn. If that frame is
+ * the previous one, the changed cells listed in the frame are used; otherwise
+ * they are found a word at a time, comparing the bits of both frames.
+ * @param frame The frame.
+ * @param draw_cell Draws a cell, given its row-major index and whether it is alive.
+ * @return true if the cells were redrawn, false if the whole board must be drawn.
+ */
+template <typename DrawCell>
+bool PngEncoder::redraw_changes(const Frame& frame, DrawCell draw_cell) {
+  const bool same_board = m_drawn.size() == frame.bits.size() && m_drawn_cols == frame.cols;
+
+  if (same_board && frame.has_changes && frame.sequence == m_drawn_sequence + 1) {
+    for (const size_t index : frame.changed) { draw_cell(index, is_alive(frame.bits.data(), index)); }
+  } else if (same_board) {
+    for (size_t word = 0; word < frame.bits.size(); ++word) {
+      for (uint64_t diff = frame.bits[word] ^ m_drawn[word]; diff != 0; diff &= diff - 1) {
+        const size_t index = word * 64 + static_cast<size_t>(__builtin_ctzll(diff));
+        draw_cell(index, is_alive(frame.bits.data(), index));
+      }
+    }
+  }
+
+  m_drawn = frame.bits;
+  m_drawn_sequence = frame.sequence;
+  m_drawn_cols = frame.cols;
+  return same_board;
+}
+
+/*!
+ * Draws the board of a frame as 1-bit palette indices, the most significant bit first.
+ * The first time, each row of cells is drawn once and copied for the other scanlines of the block.
+ * @param frame The frame.
+ */
+void PngEncoder::render_indices(const Frame& frame) {
+  const size_t line_bytes = (frame.cols * m_block_size + 7) / 8;  //!<- Scanlines start at a byte boundary.
+
+  const bool redrawn = redraw_changes(frame, [&](size_t index, bool alive) {
+    const size_t first_x = (index % frame.cols) * m_block_size;
+    unsigned char* block = m_indices.data() + (index / frame.cols) * m_block_size * line_bytes;
+
+    for (size_t y = 0; y < m_block_size; ++y, block += line_bytes) {
+      for (size_t x = first_x; x < first_x + m_block_size; ++x) {
+        const auto mask = static_cast<unsigned char>(0x80U >> (x % 8));
+        block[x / 8] = alive ? (block[x / 8] | mask) : (block[x / 8] & ~mask);
+      }
+    }
+  });
+  if (redrawn) { return; }
+
+  m_indices.assign(line_bytes * frame.rows * m_block_size, 0);
+  for (size_t r = 0; r < frame.rows; ++r) {
+    unsigned char* line = m_indices.data() + r * m_block_size * line_bytes;
+
+    for (size_t c = 0; c < frame.cols; ++c) {
+      if (!is_alive(frame.bits.data(), r * frame.cols + c)) { continue; }
+      for (size_t x = c * m_block_size; x < (c + 1) * m_block_size; ++x) {
+        line[x / 8] |= static_cast<unsigned char>(0x80U >> (x % 8));
+      }
+    }
+    for (size_t y = 1; y < m_block_size; ++y) { std::memcpy(line + y * line_bytes, line, line_bytes); }
+  }
+}
+
+/*!
+ * Draws the board of a frame as RGBA pixels. The first time, the board is
+ * drawn a whole row of cells at a time; then only the changed cells are.
+ * @param frame The frame.
+ * @return The canvas with the image.
+ */
+const Canvas& PngEncoder::render_rgba(const Frame& frame) {
+  const bool redrawn = redraw_changes(frame, [&](size_t index, bool alive) {
+    m_image.pixel(index % frame.cols, index / frame.cols, alive ? m_alive : m_bkg);
+  });
+  if (redrawn) { return m_image; }
+
+  m_image = Canvas(frame.cols, frame.rows, m_block_size);
+  const Canvas::rgba_t alive = Canvas::rgba(m_alive);
+  const Canvas::rgba_t bkg = Canvas::rgba(m_bkg);
+  m_row.resize(frame.cols);
+
+  for (size_t r = 0; r < frame.rows; ++r) {
+    for (size_t c = 0; c < frame.cols; ++c) { m_row[c] = is_alive(frame.bits.data(), r * frame.cols + c) ? alive : bkg; }
+    m_image.row(r, m_row.data());
+  }
+  return m_image;
+}
+
+}  // namespace life
@@ -0,0 +1,70 @@
+#ifndef PNG_ENCODER_H
+#define PNG_ENCODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "canvas.h"
+#include "frame.h"
+#include "lodepng.h"
+
+namespace life {
+
+/*!
+ * Encodes boards as PNG images, keeping its settings and buffers from one
+ * frame to the next.
+ *
+ * A board has only two colors, so by default each pixel is written as one
+ * bit indexing a two-color palette: the image is drawn straight from the
+ * bit-packed board into 1-bit scanlines, with no RGBA canvas and no color
+ * conversion inside `lodepng`. The `rgba` mode keeps the old 4 bytes per
+ * pixel images. The deflate settings come from the configuration.
+ *
+ * The image is kept between frames: when the previous frame was drawn by
+ * the same encoder, only the cells listed as changed are redrawn; otherwise
+ * the cells to redraw are found by comparing the bits with the last frame
+ * drawn. An encoder must always be used for the same kind of image.
+ */
+class PngEncoder {
+public:
+  /// Settings of the deflate compression.
+  struct Deflate {
+    unsigned window;     //!< LZ77 window size, a power of two up to 32768.
+    unsigned nicematch;  //!< The match search stops at this length (3 to 258).
+    bool lazy;           //!< Whether lazy matching is used.
+  };
+
+  //=== Special members
+  /// Constructor, prepares the encoder settings.
+  PngEncoder(const Color& alive, const Color& bkg, size_t block_size, bool palette, const Deflate& deflate);
+
+  //=== Members
+  /// Encodes the board of a frame.
+  bool encode(const Frame& frame, std::vector<unsigned char>& png);
+  /// Draws the board of a frame as RGBA pixels, also used for raw frames.
+  const Canvas& render_rgba(const Frame& frame);
+
+private:
+  /// Draws the board of a frame as 1-bit palette indices.
+  void render_indices(const Frame& frame);
+  /// Redraws the cells that differ from the last frame drawn.
+  template <typename DrawCell>
+  bool redraw_changes(const Frame& frame, DrawCell draw_cell);
+
+  Color m_alive;                        //!< Color of alive cells.
+  Color m_bkg;                          //!< Color of dead cells.
+  size_t m_block_size;                  //!< Pixel size of each cell.
+  bool m_palette;                       //!< Whether images are 1-bit palette images.
+  lodepng::State m_state;               //!< Encoder settings, kept between frames.
+  std::vector<unsigned char> m_indices; //!< 1-bit scanlines of the palette image.
+  Canvas m_image;                       //!< Pixels of the RGBA image, kept to redraw only what changed.
+  std::vector<Canvas::rgba_t> m_row;    //!< Colors of a row of cells.
+  std::vector<uint64_t> m_drawn;        //!< Cells of the last frame drawn.
+  size_t m_drawn_sequence{ 0 };         //!< Sequence of the last frame drawn.
+  size_t m_drawn_cols{ 0 };             //!< Number of columns of the last frame drawn.
+};
+
+}  // namespace life
+
+#endif  // PNG_ENCODER_H
@@ -0,0 +1,73 @@
+/*!
+ * Rule implementation.
+ * @file rule.cpp
+ */
+
+#include "rule.h"
+
+#include <cctype>
+
+namespace life {
+
+namespace {
+/// Reads the digits (0 to 8) of a neighbor count mask, moving past them.
+uint16_t read_counts(std::string_view& text) {
+  uint16_t mask = 0;
+  while (!text.empty() && text.front() >= '0' && text.front() <= '8') {
+    mask |= static_cast<uint16_t>(1U << (text.front() - '0'));
+    text.remove_prefix(1);
+  }
+  return mask;
+}
+
+/// Moves past a character, in any case, telling whether it was there.
+bool skip(std::string_view& text, char c) {
+  if (text.empty() || std::toupper(static_cast<unsigned char>(text.front())) != c) { return false; }
+  text.remove_prefix(1);
+  return true;
+}
+}  // namespace
+
+/*!
+ * Reads a rule in B/S notation ("B3/S23", "b36/s23", "B2/S") or in the
+ * older S/B notation ("23/3").
+ * @param text The rule.
+ * @param rule Receives the rule, if it is valid.
+ * @return true if the text is a valid rule, false otherwise.
+ */
+bool Rule::parse(std::string_view text, Rule& rule) {
+  Rule parsed;
+
+  if (skip(text, 'B')) {
+    parsed.birth = read_counts(text);
+    skip(text, '/');
+    if (!skip(text, 'S')) { return false; }
+    parsed.survival = read_counts(text);
+  } else {
+    parsed.survival = read_counts(text);
+    if (!skip(text, '/')) { return false; }
+    parsed.birth = read_counts(text);
+  }
+
+  if (!text.empty()) { return false; }
+  rule = parsed;
+  return true;
+}
+
+/*!
+ * Writes the rule in B/S notation.
+ * @return The rule, such as "B3/S23".
+ */
+std::string Rule::to_string() const {
+  std::string text = "B";
+  for (unsigned n = 0; n <= 8; ++n) {
+    if ((birth >> n) & 1U) { text += static_cast<char>('0' + n); }
+  }
+  text += "/S";
+  for (unsigned n = 0; n <= 8; ++n) {
+    if ((survival >> n) & 1U) { text += static_cast<char>('0' + n); }
+  }
+  return text;
+}
+
+}  // namespace life
@@ -0,0 +1,90 @@
+#ifndef RULE_H
+#define RULE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace life {
+
+/*!
+ * A Life-like rule in B/S notation, such as B3/S23 (Conway's Life) or
+ * B36/S23 (HighLife): bit `n` of a mask is set if a cell with `n` alive
+ * neighbors is born (birth) or stays alive (survival).
+ */
+struct Rule {
+  uint16_t birth{ 1U << 3 };                   //!< Neighbor counts that give birth to a dead cell.
+  uint16_t survival{ (1U << 2) | (1U << 3) };  //!< Neighbor counts that keep an alive cell alive.
+
+  /// Reads a rule in B/S ("B3/S23") or S/B ("23/3") notation.
+  static bool parse(std::string_view text, Rule& rule);
+  /// Writes the rule in B/S notation.
+  [[nodiscard]] std::string to_string() const;
+  /// Tells whether a dead cell with a number of alive neighbors is born.
+  [[nodiscard]] bool born(unsigned neighbors) const { return (birth >> neighbors) & 1U; }
+  /// Equality operator.
+  bool operator==(const Rule& other) const { return birth == other.birth && survival == other.survival; }
+};
+
+/// Next state of a cell, indexed by whether it is alive and by its number of alive neighbors.
+struct StateTable {
+  uint8_t next[2][9];  //!< 1 if the cell is alive in the next generation, 0 otherwise.
+};
+
+/// Fills the state table of a rule.
+constexpr StateTable make_state_table(uint16_t birth, uint16_t survival) {
+  StateTable table{};
+  for (unsigned n = 0; n <= 8; ++n) {
+    table.next[0][n] = (birth >> n) & 1U;
+    table.next[1][n] = (survival >> n) & 1U;
+  }
+  return table;
+}
+
+/// A rule whose masks are compile-time constants, so the kernels fold its tests.
+template <uint16_t Birth, uint16_t Survival>
+struct StaticRule {
+  static constexpr uint16_t birth = Birth;        //!< Neighbor counts that give birth to a dead cell.
+  static constexpr uint16_t survival = Survival;  //!< Neighbor counts that keep an alive cell alive.
+  static constexpr StateTable table = make_state_table(Birth, Survival);  //!< Next state of each cell.
+};
+
+typedef StaticRule<0x008, 0x00C> ConwayRule;    //!< B3/S23, Conway's Life.
+typedef StaticRule<0x048, 0x00C> HighLifeRule;  //!< B36/S23, HighLife.
+typedef StaticRule<0x004, 0x000> SeedsRule;     //!< B2/S, Seeds.
+
+/// A rule looked up in a table filled at runtime, for the rules without a specialized kernel.
+struct TableRule {
+  uint16_t birth;    //!< Neighbor counts that give birth to a dead cell.
+  uint16_t survival; //!< Neighbor counts that keep an alive cell alive.
+  StateTable table;  //!< Next state of each cell.
+
+  /// Constructor, fills the table of a rule.
+  explicit TableRule(const Rule& rule)
+      : birth(rule.birth), survival(rule.survival), table(make_state_table(rule.birth, rule.survival)) {}
+};
+
+/*!
+ * Calls a function with the kernel rule of a rule: one of the static rules
+ * for the common rules, or a table rule for any other. The function is
+ * usually a generic lambda, so each rule gets its own compiled kernel.
+ * @param rule The rule of the simulation.
+ * @param function Function called with the kernel rule.
+ */
+template <typename Function>
+void with_rule(const Rule& rule, Function&& function) {
+  if (rule.birth == ConwayRule::birth && rule.survival == ConwayRule::survival) {
+    function(ConwayRule{});
+  } else if (rule.birth == HighLifeRule::birth && rule.survival == HighLifeRule::survival) {
+    function(HighLifeRule{});
+  } else if (rule.birth == SeedsRule::birth && rule.survival == SeedsRule::survival) {
+    function(SeedsRule{});
+  } else {
+    function(TableRule(rule));
+  }
+}
+
+}  // namespace life
+
+#endif  // RULE_H
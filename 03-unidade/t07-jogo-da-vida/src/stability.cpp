@@ -0,0 +1,161 @@
+/*!
+ * StabilityDetector class implementation.
+ * @file stability.cpp
+ */
+
+#include "stability.h"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+
+#include "life.h"
+
+namespace life {
+
+namespace {
+/// Hashes the words of a plane key, mixing each one into the hash of the previous ones.
+StabilityDetector::hash_t hash_words(const std::vector<uint64_t>& words) {
+  StabilityDetector::hash_t hash = words.size();
+  for (const uint64_t word : words) {
+    hash = (hash ^ word) * 0x9E3779B97F4A7C15ULL;
+    hash ^= hash >> 29;
+  }
+  return hash;
+}
+}  // namespace
+
+/*!
+ * Creates the Zobrist keys for a board of the given size.
+ * A fixed seed keeps the hashes reproducible between runs.
+ * @param rows Number of rows of the board.
+ * @param cols Number of columns of the board.
+ */
+void StabilityDetector::init_keys(size_t rows, size_t cols) {
+  std::mt19937_64 engine(0x5EED0F11FEULL);
+
+  m_rows = rows;
+  m_cols = cols;
+  m_keys.resize(rows * cols);
+  for (auto& key : m_keys) { key = engine(); }
+}
+
+/*!
+ * Packs a board into m_packed and computes its hash.
+ * @param cfg The board to be packed.
+ * @return The Zobrist hash of the board.
+ */
+StabilityDetector::hash_t StabilityDetector::pack(const LifeCfg& cfg) {
+  hash_t hash = 0;
+  size_t index = 0;
+
+  m_packed.assign((m_rows * m_cols + 63) / 64, 0);
+  for (size_t r = 1; r <= m_rows; ++r) {
+    for (size_t c = 1; c <= m_cols; ++c, ++index) {
+      if (cfg.get_cell(r, c).is_alive) {
+        m_packed[index / 64] |= uint64_t{ 1 } << (index % 64);
+        hash ^= m_keys[index];
+      }
+    }
+  }
+  return hash;
+}
+
+/*!
+ * Records a generation and tells whether its board was already observed.
+ * Boards are only compared when their hashes collide. On a plane the key of
+ * the whole plane is observed instead of the board window.
+ * @param cfg The board of the generation.
+ * @param generation The generation number.
+ * @return true if an identical board was observed before, false otherwise.
+ */
+bool StabilityDetector::observe(const LifeCfg& cfg, size_t generation) {
+  const bool plane = cfg.plane_key(m_packed);
+  if (plane != m_plane) {
+    clear();
+    m_plane = plane;
+  }
+  if (!plane && (m_keys.empty() || cfg.m_rows != m_rows || cfg.m_cols != m_cols)) {
+    clear();
+    init_keys(cfg.m_rows, cfg.m_cols);
+  }
+
+  const hash_t hash = plane ? hash_words(m_packed) : pack(cfg);
+  auto& candidates = m_seen[hash];
+
+  for (const size_t index : candidates) {
+    /// An evicted board can only be compared by its hash.
+    if (!m_history.get(index, m_candidate) || m_candidate == m_packed) {
+      m_first_generation = m_generations[index];
+      return true;
+    }
+  }
+
+  candidates.push_back(m_generations.size());
+  m_history.push(m_packed);
+  m_generations.push_back(generation);
+  m_hashes.push_back(hash);
+  return false;
+}
+
+/*!
+ * Forgets every observed generation.
+ */
+void StabilityDetector::clear() {
+  m_first_generation = 0;
+  m_history.clear();
+  m_generations.clear();
+  m_hashes.clear();
+  m_seen.clear();
+}
+
+/*!
+ * Sets the keyframe interval and memory cap of the history of boards,
+ * forgetting every observed generation.
+ * @param keyframe_every Boards between two keyframes.
+ * @param memory_cap Maximum bytes of the history, zero for no limit.
+ */
+void StabilityDetector::set_history(size_t keyframe_every, size_t memory_cap) {
+  clear();
+  m_history.configure(keyframe_every, memory_cap);
+}
+
+/*!
+ * Rebuilds the board of an observed generation.
+ * @param generation The generation.
+ * @param board Receives the bit-packed board.
+ * @return true if the generation was observed and its board is still kept, false otherwise
+ * (or if the observed boards are plane keys).
+ */
+bool StabilityDetector::board_of(size_t generation, std::vector<uint64_t>& board) const {
+  if (m_plane) { return false; }
+  const auto found = std::lower_bound(m_generations.begin(), m_generations.end(), generation);
+  if (found == m_generations.end() || *found != generation) { return false; }
+  return m_history.get(static_cast<size_t>(found - m_generations.begin()), board);
+}
+
+/*!
+ * Replaces the observed generations, e.g. with the ones saved in a checkpoint.
+ * Evicted boards keep their hashes, so they are still matched by hash.
+ * @param rows Number of rows of the boards.
+ * @param cols Number of columns of the boards.
+ * @param generations Generation of each board.
+ * @param hashes Hash of each board.
+ * @param history Bit-packed boards in row-major order (or plane keys), by observation index.
+ * @param plane Whether the history holds plane keys.
+ */
+void StabilityDetector::restore(size_t rows, size_t cols, std::vector<size_t> generations, std::vector<hash_t> hashes,
+                                HistoryStore&& history, bool plane) {
+  clear();
+  init_keys(rows, cols);
+  m_plane = plane;
+  m_generations = std::move(generations);
+  m_hashes = std::move(hashes);
+  m_hashes.resize(m_generations.size());
+  const size_t kept = history.first();
+  m_history.splice(std::move(history), kept);
+
+  for (size_t index = 0; index < m_hashes.size(); ++index) { m_seen[m_hashes[index]].push_back(index); }
+}
+
+}  // namespace life
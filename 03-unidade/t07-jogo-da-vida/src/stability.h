@@ -0,0 +1,90 @@
+#ifndef STABILITY_H
+#define STABILITY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "history.h"
+
+namespace life {
+
+class LifeCfg;
+
+/*!
+ * Detects when a simulation reaches a configuration it has already been in.
+ *
+ * Each observed generation is reduced to a 64-bit Zobrist hash (the XOR of
+ * a random key per alive cell) and stored in a hash map, so a new board is
+ * only compared cell by cell against earlier boards with the same hash.
+ * Boards are kept bit-packed for that comparison, one bit per cell, in a
+ * HistoryStore of keyframes and deltas. When its memory cap evicts a board,
+ * a board with the same hash is taken as a repetition of it.
+ *
+ * On an unbounded plane the board is only a window, so the engine describes
+ * the whole plane instead (Engine::plane_key()); those keys are hashed and
+ * compared in place of the bit-packed windows.
+ */
+class StabilityDetector {
+public:
+  //=== Alias
+  typedef uint64_t hash_t;  //!< Type of a board hash.
+
+  //=== Special members
+  /// Constructor
+  StabilityDetector() = default;
+  /// Destructor
+  ~StabilityDetector() = default;
+
+  //=== Members
+  /// Records a generation and tells whether its board was already observed.
+  bool observe(const LifeCfg& cfg, size_t generation);
+  /// Forgets every observed generation.
+  void clear();
+  /// Sets the keyframe interval and memory cap of the history, forgetting every observed generation.
+  void set_history(size_t keyframe_every, size_t memory_cap);
+  /// Rebuilds the board of an observed generation, telling whether it is still kept.
+  bool board_of(size_t generation, std::vector<uint64_t>& board) const;
+  /// Replaces the observed generations, e.g. with the ones saved in a checkpoint.
+  void restore(size_t rows, size_t cols, std::vector<size_t> generations, std::vector<hash_t> hashes,
+               HistoryStore&& history, bool plane);
+
+  //=== Attribute accessors members.
+  /// Generation in which the repeated board first appeared.
+  [[nodiscard]] size_t first_generation() const { return m_first_generation; }
+  /// Number of generations observed so far.
+  [[nodiscard]] size_t size() const { return m_generations.size(); }
+  /// Generation of each observed board, in the order they were observed.
+  [[nodiscard]] const std::vector<size_t>& generations() const { return m_generations; }
+  /// Hash of each observed board, in the order they were observed.
+  [[nodiscard]] const std::vector<hash_t>& hashes() const { return m_hashes; }
+  /// Observed boards, bit-packed in row-major order, by observation index.
+  [[nodiscard]] const HistoryStore& history() const { return m_history; }
+  /// Whether the observed boards are keys of a whole plane instead of bit-packed windows.
+  [[nodiscard]] bool plane() const { return m_plane; }
+  /// Bit-packed board (or plane key) of the last observed generation.
+  [[nodiscard]] const std::vector<uint64_t>& last_board() const { return m_packed; }
+
+private:
+  /// Creates the Zobrist keys for a board of the given size.
+  void init_keys(size_t rows, size_t cols);
+  /// Packs a board into m_packed and computes its hash.
+  hash_t pack(const LifeCfg& cfg);
+
+  size_t m_rows{ 0 };                     //!< Rows of the boards being observed.
+  size_t m_cols{ 0 };                     //!< Columns of the boards being observed.
+  size_t m_first_generation{ 0 };         //!< Generation matched by the last repeated board.
+  bool m_plane{ false };                  //!< Whether the observed boards are plane keys.
+  std::vector<hash_t> m_keys;             //!< Random key of each cell.
+  std::vector<uint64_t> m_packed;         //!< Bit-packed copy (or plane key) of the last observed board.
+  std::vector<uint64_t> m_candidate;      //!< Earlier board being compared with the last one.
+  HistoryStore m_history;                 //!< Bit-packed boards already observed.
+  std::vector<size_t> m_generations;      //!< Generation of each stored board.
+  std::vector<hash_t> m_hashes;           //!< Hash of each stored board.
+  std::unordered_map<hash_t, std::vector<size_t>> m_seen;  //!< Indices of the boards with a given hash.
+};
+
+}  // namespace life
+
+#endif  // STABILITY_H
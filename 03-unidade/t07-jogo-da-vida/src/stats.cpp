@@ -0,0 +1,195 @@
+/*!
+ * StatsRecorder class implementation.
+ * @file stats.cpp
+ */
+
+#include "stats.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+
+#include "life.h"
+
+namespace life {
+
+namespace {
+/// Tells whether a row of the window has an alive cell.
+bool row_alive(const LifeCfg& cfg, size_t r) {
+  for (size_t c = 1; c <= cfg.m_cols; ++c) {
+    if (cfg.get_cell(r, c).is_alive) { return true; }
+  }
+  return false;
+}
+
+/*!
+ * Finds the bounding box of the alive cells of the window, scanning from
+ * each edge: the rows stop at the first alive cell from the top and from
+ * the bottom, and each row between them only looks at the cells outside the
+ * box found so far.
+ * @param cfg The board.
+ * @param stats Receives the bounding box.
+ */
+void window_box(const LifeCfg& cfg, GenerationStats& stats) {
+  for (size_t r = 1; r <= cfg.m_rows && stats.min_row == 0; ++r) {
+    if (row_alive(cfg, r)) { stats.min_row = r; }
+  }
+  if (stats.min_row == 0) { return; }
+  for (size_t r = cfg.m_rows; r >= stats.min_row && stats.max_row == 0; --r) {
+    if (row_alive(cfg, r)) { stats.max_row = r; }
+  }
+
+  size_t first = cfg.m_cols + 1;
+  size_t last = 0;
+  for (size_t r = stats.min_row; r <= stats.max_row; ++r) {
+    for (size_t c = 1; c < first; ++c) {
+      if (cfg.get_cell(r, c).is_alive) {
+        first = c;
+        break;
+      }
+    }
+    for (size_t c = cfg.m_cols; c > last && c >= first; --c) {
+      if (cfg.get_cell(r, c).is_alive) {
+        last = c;
+        break;
+      }
+    }
+  }
+  stats.min_col = first;
+  stats.max_col = last;
+}
+}  // namespace
+
+/*!
+ * Allocates the ring buffer.
+ * @param capacity Number of generations kept, at least one.
+ */
+StatsRecorder::StatsRecorder(size_t capacity) : m_ring(std::max<size_t>(capacity, 1)) {}
+
+/*!
+ * Records the statistics of the current generation of a board.
+ * The population of an engine comes from its own count, which covers the
+ * whole plane of the engines that simulate one; the bounding box only
+ * covers the window. The births and deaths come from the cells the board
+ * recorded as changed, which cover the previous generation only when a
+ * single generation was computed since the last record; otherwise they are
+ * zero.
+ * @param cfg The board.
+ * @param generation The generation number.
+ * @param step_ms Time spent computing the generation.
+ */
+void StatsRecorder::record(const LifeCfg& cfg, size_t generation, double step_ms) {
+  GenerationStats stats;
+  stats.generation = generation;
+  stats.step_ms = step_ms;
+
+  if (cfg.has_engine()) {
+    /// The engine counts the alive cells itself, so only the bounding box is looked for.
+    stats.population = cfg.population();
+    window_box(cfg, stats);
+  } else {
+    /// Population and bounding box of the board, a row at a time.
+    for (size_t r = 1; r <= cfg.m_rows; ++r) {
+      size_t first = 0;
+      size_t last = 0;
+      for (size_t c = 1; c <= cfg.m_cols; ++c) {
+        if (!cfg.get_cell(r, c).is_alive) { continue; }
+        ++stats.population;
+        if (first == 0) { first = c; }
+        last = c;
+      }
+      if (first == 0) { continue; }
+
+      if (stats.min_row == 0) { stats.min_row = r; }
+      stats.max_row = r;
+      stats.min_col = stats.min_col == 0 ? first : std::min(stats.min_col, first);
+      stats.max_col = std::max(stats.max_col, last);
+    }
+  }
+
+  /// Births and deaths, from the cells that flipped in the last update.
+  if (m_has_last && cfg.update_count() == m_last_update + 1) {
+    for (size_t r = 1; r <= cfg.m_rows; ++r) {
+      for (const uint32_t c : cfg.changed_cells(r)) {
+        if (cfg.get_cell(r, c).is_alive) {
+          ++stats.births;
+        } else {
+          ++stats.deaths;
+        }
+      }
+    }
+  }
+  m_last_update = cfg.update_count();
+  m_has_last = true;
+
+  /// Store the record, over the oldest one if the ring is full.
+  if (m_size < m_ring.size()) {
+    m_ring[(m_first + m_size++) % m_ring.size()] = stats;
+  } else {
+    m_ring[m_first] = stats;
+    m_first = (m_first + 1) % m_ring.size();
+    ++m_dropped;
+  }
+}
+
+/*!
+ * Writes the records: as JSON if the file name ends with ".json", as CSV otherwise.
+ * @param filename Name of the file.
+ * @return true if the file was written, false otherwise.
+ */
+bool StatsRecorder::save(const std::string& filename) const {
+  if (std::filesystem::path(filename).extension() == ".json") { return write_json(filename); }
+  return write_csv(filename);
+}
+
+/*!
+ * Writes the records as a CSV table, one generation per line.
+ * @param filename Name of the file.
+ * @return true if the file was written, false otherwise.
+ */
+bool StatsRecorder::write_csv(const std::string& filename) const {
+  std::ofstream csv(filename);
+  if (!csv.is_open()) { return false; }
+
+  csv << "generation,population,births,deaths,window_min_row,window_min_col,window_max_row,window_max_col,step_ms\n";
+  csv << std::fixed << std::setprecision(4);
+  for (size_t i = 0; i < m_size; ++i) {
+    const GenerationStats& stats = at(i);
+    csv << stats.generation << ',' << stats.population << ',' << stats.births << ',' << stats.deaths << ','
+        << stats.min_row << ',' << stats.min_col << ',' << stats.max_row << ',' << stats.max_col << ','
+        << stats.step_ms << '\n';
+  }
+  return static_cast<bool>(csv);
+}
+
+/*!
+ * Writes the records as a JSON document: the number of dropped records and
+ * one object per generation, whose bounding box (of the window) is null when
+ * no cell of the window is alive.
+ * @param filename Name of the file.
+ * @return true if the file was written, false otherwise.
+ */
+bool StatsRecorder::write_json(const std::string& filename) const {
+  std::ofstream json(filename);
+  if (!json.is_open()) { return false; }
+
+  json << "{\n  \"dropped\": " << m_dropped << ",\n  \"generations\": [";
+  json << std::fixed << std::setprecision(4);
+  for (size_t i = 0; i < m_size; ++i) {
+    const GenerationStats& stats = at(i);
+    json << (i > 0 ? ",\n    " : "\n    ") << "{\"generation\": " << stats.generation
+         << ", \"population\": " << stats.population << ", \"births\": " << stats.births
+         << ", \"deaths\": " << stats.deaths << ", \"window_bounding_box\": ";
+    if (stats.min_row == 0) {
+      json << "null";
+    } else {
+      json << "[" << stats.min_row << ", " << stats.min_col << ", " << stats.max_row << ", " << stats.max_col << "]";
+    }
+    json << ", \"step_ms\": " << stats.step_ms << "}";
+  }
+  json << "\n  ]\n}\n";
+  return static_cast<bool>(json);
+}
+
+}  // namespace life
@@ -0,0 +1,72 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace life {
+
+class LifeCfg;
+
+/// Statistics of one generation of a simulation.
+struct GenerationStats {
+  size_t generation{ 0 };  //!< Generation number.
+  size_t population{ 0 };  //!< Number of alive cells, in the whole plane for the engines that simulate one.
+  size_t births{ 0 };      //!< Cells born in the window since the previous generation.
+  size_t deaths{ 0 };      //!< Cells of the window that died since the previous generation.
+  size_t min_row{ 0 };     //!< First row of the window with an alive cell, zero if there is none.
+  size_t min_col{ 0 };     //!< First column of the window with an alive cell, zero if there is none.
+  size_t max_row{ 0 };     //!< Last row of the window with an alive cell, zero if there is none.
+  size_t max_col{ 0 };     //!< Last column of the window with an alive cell, zero if there is none.
+  double step_ms{ 0 };     //!< Time spent computing the generation from the previous one.
+};
+
+/*!
+ * Records the statistics of each generation of a simulation.
+ *
+ * The records go into a ring buffer allocated once, so recording never
+ * allocates; when a simulation outlives the buffer, the oldest records are
+ * dropped and the last `capacity` generations are kept. The records are
+ * written at the end, as CSV or JSON.
+ *
+ * The population comes from the engine, which counts the whole plane when it
+ * simulates one; the bounding box, births and deaths only see the window.
+ */
+class StatsRecorder {
+public:
+  //=== Special members
+  /// Constructor, allocates the ring buffer.
+  explicit StatsRecorder(size_t capacity);
+
+  //=== Members
+  /// Records the statistics of the current generation of a board.
+  void record(const LifeCfg& cfg, size_t generation, double step_ms);
+  /// Writes the records, in CSV or JSON according to the file extension.
+  bool save(const std::string& filename) const;
+
+  //=== Attribute accessors members.
+  /// Number of records kept.
+  [[nodiscard]] size_t size() const { return m_size; }
+  /// Number of records dropped because the buffer was full.
+  [[nodiscard]] size_t dropped() const { return m_dropped; }
+
+private:
+  /// Record at a position of the ring, zero being the oldest one.
+  [[nodiscard]] const GenerationStats& at(size_t index) const { return m_ring[(m_first + index) % m_ring.size()]; }
+  /// Writes the records as a CSV table.
+  bool write_csv(const std::string& filename) const;
+  /// Writes the records as a JSON document.
+  bool write_json(const std::string& filename) const;
+
+  std::vector<GenerationStats> m_ring;  //!< The records, allocated once.
+  size_t m_first{ 0 };                  //!< Position of the oldest record.
+  size_t m_size{ 0 };                   //!< Number of records kept.
+  size_t m_dropped{ 0 };                //!< Number of records overwritten.
+  size_t m_last_update{ 0 };            //!< Update count of the board in the last record.
+  bool m_has_last{ false };             //!< Whether a generation was recorded already.
+};
+
+}  // namespace life
+
+#endif  // STATS_H
@@ -0,0 +1,240 @@
+/*!
+ * TerminalRenderer class implementation.
+ * @file terminal.cpp
+ */
+
+#include "terminal.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <iostream>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include "life.h"
+
+namespace life {
+
+namespace {
+constexpr char alive_glyph[] = "•";               //!< UTF-8 bullet drawn for an alive cell.
+constexpr size_t glyph_bytes = 3;                 //!< Longest UTF-8 encoding of a glyph.
+constexpr const char* half_glyphs[4] = { " ", "▀", "▄", "█" };  //!< By top bit | bottom bit << 1.
+constexpr char cursor_home[] = "\x1b[H";           //!< Moves the cursor to the top-left corner.
+constexpr char clear_screen[] = "\x1b[H\x1b[2J";   //!< Clears the terminal.
+constexpr size_t max_escape_bytes = 16;           //!< Longest escape sequence of a line.
+
+/// Braille dot bits of a dot row, by its left bit | right bit << 1.
+constexpr uint8_t braille_dots[4][4] = {
+  { 0x00, 0x01, 0x08, 0x09 },
+  { 0x00, 0x02, 0x10, 0x12 },
+  { 0x00, 0x04, 0x20, 0x24 },
+  { 0x00, 0x40, 0x80, 0xC0 },
+};
+
+/// Whether a dot of a bit row is set.
+inline bool dot(const uint64_t* bits, size_t x) { return (bits[x >> 6] >> (x & 63)) & 1U; }
+}  // namespace
+
+/*!
+ * Selects the viewport and reserves the frame buffer for its largest frame, so drawing never allocates.
+ * A viewport size of zero fits the terminal, or the board when the output is not a terminal.
+ * @param rows Number of rows of the board.
+ * @param cols Number of columns of the board.
+ * @param conf The configuration, with the text mode, glyph, zoom and viewport.
+ * @param fd File descriptor of the terminal.
+ */
+TerminalRenderer::TerminalRenderer(size_t rows, size_t cols, Config& conf, int fd)
+    : m_glyph(conf.get_glyph() == "braille" ? e_glyph::BRAILLE
+              : conf.get_glyph() == "half"  ? e_glyph::HALF
+                                            : e_glyph::BULLET),
+      m_dot_rows(m_glyph == e_glyph::BULLET ? 1 : m_glyph == e_glyph::HALF ? 2 : 4),
+      m_dot_cols(m_glyph == e_glyph::BRAILLE ? 2 : 1),
+      m_zoom(conf.get_zoom()),
+      m_top(std::clamp<size_t>(conf.get_view_row(), 1, rows)),
+      m_left(std::clamp<size_t>(conf.get_view_col(), 1, cols)),
+      m_in_place(conf.get_text_mode() != "scroll"),
+      m_changed_only(conf.get_text_mode() == "diff"),
+      m_fd(fd) {
+  const size_t glyph_rows = m_dot_rows * m_zoom;  //!<- Board rows of a line of glyphs.
+  const size_t glyph_cols = m_dot_cols * m_zoom;  //!<- Board columns of a glyph.
+  m_view_rows = rows - m_top + 1;
+  m_view_cols = cols - m_left + 1;
+
+  /// Fit the terminal, keeping a line for the generation and one for the messages.
+  winsize size{};
+  const bool terminal = ::ioctl(fd, TIOCGWINSZ, &size) == 0 && size.ws_row > 0 && size.ws_col > 0;
+  if (conf.get_view_rows() > 0) {
+    m_view_rows = std::min(m_view_rows, conf.get_view_rows());
+  } else if (terminal) {
+    m_view_rows = std::min(m_view_rows, (std::max<size_t>(size.ws_row, 3) - 2) * glyph_rows);
+  }
+  if (conf.get_view_cols() > 0) {
+    m_view_cols = std::min(m_view_cols, conf.get_view_cols());
+  } else if (terminal) {
+    m_view_cols = std::min(m_view_cols, (std::max<size_t>(size.ws_col, 3) - 2) * glyph_cols);
+  }
+
+  m_lines = (m_view_rows + glyph_rows - 1) / glyph_rows;
+  m_chars = (m_view_cols + glyph_cols - 1) / glyph_cols;
+  m_words = (m_chars * m_dot_cols + 63) / 64;
+  m_bits.assign(m_dot_rows * m_words, 0);
+  m_dirty.assign(m_lines, 0);
+  m_frame.reserve(2 * max_escape_bytes + 32 + m_lines * (m_chars * glyph_bytes + 3 + max_escape_bytes));
+}
+
+/*!
+ * Draws a generation of the board, over the previous one when drawn in place.
+ * Only the changed lines are written when requested and the board computed a
+ * single generation since the previous frame; otherwise the whole viewport is.
+ * @param cfg The board.
+ * @param generation The generation number.
+ */
+void TerminalRenderer::draw(const LifeCfg& cfg, int generation) {
+  const bool whole = m_first || !m_changed_only || cfg.update_count() != m_last_update + 1;
+
+  m_frame.clear();
+  if (m_in_place) { m_frame += m_first ? clear_screen : cursor_home; }
+  m_frame += "Generation ";
+  m_frame += std::to_string(generation);
+  m_frame += ":\n";
+
+  if (whole) {
+    for (size_t line = 0; line < m_lines; ++line) { append_line(cfg, line); }
+  } else {
+    mark_changed(cfg);
+    for (size_t line = 0; line < m_lines; ++line) {
+      if (!m_dirty[line]) { continue; }
+      move_to(line + 2);
+      append_line(cfg, line);
+    }
+    move_to(m_lines + 2);
+  }
+
+  m_first = false;
+  m_last_update = cfg.update_count();
+  flush();
+}
+
+/*!
+ * Packs the dots of a line of glyphs into m_bits, a bit row per dot row.
+ * A dot is set if any cell of the square of `zoom` cells of side it covers is alive.
+ * @param cfg The board.
+ * @param line The line of glyphs.
+ */
+void TerminalRenderer::pack_line(const LifeCfg& cfg, size_t line) {
+  std::fill(m_bits.begin(), m_bits.end(), 0);
+
+  const size_t end_row = m_top + m_view_rows;
+  for (size_t k = 0; k < m_dot_rows; ++k) {
+    uint64_t* bits = &m_bits[k * m_words];
+    const size_t first_row = m_top + (line * m_dot_rows + k) * m_zoom;
+
+    for (size_t r = first_row; r < std::min(first_row + m_zoom, end_row); ++r) {
+      const Cell* cells = cfg.m_board.data() + r * cfg.get_expanded_cols() + m_left;
+      size_t c = 0;
+      for (size_t x = 0; c < m_view_cols; ++x) {
+        const size_t end = std::min(c + m_zoom, m_view_cols);
+        bool alive = false;
+        for (; c < end; ++c) { alive |= cells[c].is_alive; }
+        bits[x >> 6] |= static_cast<uint64_t>(alive) << (x & 63);
+      }
+    }
+  }
+}
+
+/*!
+ * Appends a line of glyphs to the frame, composed from the packed dots.
+ * @param cfg The board.
+ * @param line The line of glyphs.
+ */
+void TerminalRenderer::append_line(const LifeCfg& cfg, size_t line) {
+  pack_line(cfg, line);
+  const uint64_t* top = m_bits.data();
+
+  m_frame += '[';
+  switch (m_glyph) {
+    case e_glyph::BULLET:
+      for (size_t x = 0; x < m_chars; ++x) {
+        if (dot(top, x)) {
+          m_frame.append(alive_glyph, sizeof(alive_glyph) - 1);
+        } else {
+          m_frame += ' ';
+        }
+      }
+      break;
+    case e_glyph::HALF:
+      for (size_t x = 0; x < m_chars; ++x) {
+        m_frame += half_glyphs[dot(top, x) | dot(top + m_words, x) << 1];
+      }
+      break;
+    case e_glyph::BRAILLE:
+      for (size_t x = 0; x < m_chars; ++x) {
+        /// Two dots of each of the four bit rows, never split between words.
+        const size_t word = (2 * x) >> 6;
+        const size_t shift = (2 * x) & 63;
+        unsigned code = 0;
+        for (size_t k = 0; k < 4; ++k) { code |= braille_dots[k][(m_bits[k * m_words + word] >> shift) & 3U]; }
+
+        if (code == 0) {
+          m_frame += ' ';
+        } else {
+          /// U+2800 + code, in UTF-8.
+          m_frame += static_cast<char>(0xE2);
+          m_frame += static_cast<char>(0xA0 | (code >> 6));
+          m_frame += static_cast<char>(0x80 | (code & 0x3F));
+        }
+      }
+      break;
+  }
+  m_frame += "]\n";
+}
+
+/*!
+ * Marks the lines with a cell of the viewport that flipped in the last update.
+ * @param cfg The board.
+ */
+void TerminalRenderer::mark_changed(const LifeCfg& cfg) {
+  std::fill(m_dirty.begin(), m_dirty.end(), 0);
+
+  const size_t glyph_rows = m_dot_rows * m_zoom;
+  for (size_t r = m_top; r < m_top + m_view_rows; ++r) {
+    for (const uint32_t c : cfg.changed_cells(r)) {
+      if (c >= m_left && c < m_left + m_view_cols) {
+        m_dirty[(r - m_top) / glyph_rows] = 1;
+        break;
+      }
+    }
+  }
+}
+
+/*!
+ * Appends a sequence that moves the cursor to the start of a line of the terminal.
+ * @param line The line, counted from one.
+ */
+void TerminalRenderer::move_to(size_t line) {
+  m_frame += "\x1b[";
+  m_frame += std::to_string(line);
+  m_frame += ";1H";
+}
+
+/*!
+ * Writes the frame with a single write(2), retried only if it is interrupted
+ * or partial. The standard output is flushed first, so earlier messages come before it.
+ */
+void TerminalRenderer::flush() {
+  std::cout.flush();
+
+  const char* data = m_frame.data();
+  size_t left = m_frame.size();
+  while (left > 0) {
+    const ssize_t written = ::write(m_fd, data, left);
+    if (written < 0) {
+      if (errno == EINTR) { continue; }
+      return;
+    }
+    data += written;
+    left -= static_cast<size_t>(written);
+  }
+}
+
+}  // namespace life
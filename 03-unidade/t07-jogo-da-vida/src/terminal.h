@@ -0,0 +1,87 @@
+#ifndef TERMINAL_H
+#define TERMINAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Config;
+
+namespace life {
+
+class LifeCfg;
+
+/// Characters used to draw the cells of the board.
+enum class e_glyph : short {
+  BULLET = 0,  //!< A cell per character.
+  HALF,        //!< Half blocks, 2x1 cells per character.
+  BRAILLE,     //!< Braille dots, 4x2 cells per character.
+};
+
+/*!
+ * Draws the generations of a board on a terminal.
+ *
+ * Each frame is built into a buffer reserved once for the largest frame and
+ * written with a single write(2). In place, a frame starts with a
+ * cursor-home sequence instead of scrolling the terminal, and when only the
+ * changed lines are requested the lines whose cells did not change since
+ * the previous frame are skipped, each changed line being preceded by a
+ * cursor-position sequence. Every frame leaves the cursor below the board,
+ * where the messages that follow the simulation are printed.
+ *
+ * Only a viewport of the board is drawn, by default the part that fits the
+ * terminal. Its cells are packed into bit rows, each dot covering a square
+ * of `zoom` cells of side, and the glyphs are composed from the bits, so the
+ * output grows with the size of the terminal instead of the board.
+ */
+class TerminalRenderer {
+public:
+  //=== Special members
+  /// Constructor, selects the viewport and reserves the frame buffer for a board.
+  TerminalRenderer(size_t rows, size_t cols, Config& conf, int fd);
+
+  //=== Members
+  /// Draws a generation of the board.
+  void draw(const LifeCfg& cfg, int generation);
+
+  //=== Attribute accessors members.
+  /// Number of bytes written by the last frame.
+  [[nodiscard]] size_t frame_bytes() const { return m_frame.size(); }
+
+private:
+  /// Packs the dots of a line of glyphs into m_bits.
+  void pack_line(const LifeCfg& cfg, size_t line);
+  /// Appends a line of glyphs to the frame.
+  void append_line(const LifeCfg& cfg, size_t line);
+  /// Marks the lines whose cells changed in the last update.
+  void mark_changed(const LifeCfg& cfg);
+  /// Appends a cursor-position sequence to the frame.
+  void move_to(size_t line);
+  /// Writes the frame to the terminal.
+  void flush();
+
+  std::string m_frame;          //!< The frame being built, reserved once.
+  std::vector<uint64_t> m_bits; //!< Dots of the line being drawn, a bit row per dot row.
+  std::vector<uint8_t> m_dirty; //!< Lines whose cells changed since the previous frame.
+  e_glyph m_glyph;              //!< Characters used to draw the cells.
+  size_t m_dot_rows;            //!< Dot rows of each glyph.
+  size_t m_dot_cols;            //!< Dot columns of each glyph.
+  size_t m_zoom;                //!< Cells of each side of a dot.
+  size_t m_top;                 //!< First board row of the viewport.
+  size_t m_left;                //!< First board column of the viewport.
+  size_t m_view_rows;           //!< Board rows of the viewport.
+  size_t m_view_cols;           //!< Board columns of the viewport.
+  size_t m_lines;               //!< Lines of glyphs of a frame.
+  size_t m_chars;               //!< Glyphs of each line.
+  size_t m_words;               //!< Words of each bit row.
+  bool m_in_place;              //!< Whether the frames are drawn over each other.
+  bool m_changed_only;          //!< Whether only the changed lines are written.
+  int m_fd;                     //!< File descriptor of the terminal.
+  bool m_first{ true };         //!< Whether no frame was drawn yet.
+  size_t m_last_update{ 0 };    //!< Update count of the board in the last frame.
+};
+
+}  // namespace life
+
+#endif  // TERMINAL_H
@@ -0,0 +1,128 @@
+/*!
+ * ThreadPool class implementation.
+ * @file thread_pool.cpp
+ */
+
+#include "thread_pool.h"
+
+#include <algorithm>
+
+namespace life {
+
+/*!
+ * Starts the worker threads.
+ * @param n_threads Number of threads taking part in each job, the calling one included.
+ */
+ThreadPool::ThreadPool(size_t n_threads) {
+  for (size_t i = 1; i < n_threads; ++i) {
+    m_workers.emplace_back(&ThreadPool::worker_loop, this);
+  }
+}
+
+/*!
+ * Stops and joins the worker threads.
+ */
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wake.notify_all();
+  for (auto& worker : m_workers) { worker.join(); }
+}
+
+/*!
+ * Main loop of a worker thread: waits for a job, works on it and reports back.
+ */
+void ThreadPool::worker_loop() {
+  size_t seen = 0;  //!< Last job this worker took part in.
+
+  for (;;) {
+    const std::function<void(size_t)>* task;
+    size_t n_tasks;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_wake.wait(lock, [&] { return m_stop || m_job != seen; });
+      if (m_stop) { return; }
+      seen = m_job;
+      task = m_task;
+      n_tasks = m_n_tasks;
+    }
+
+    work(*task, n_tasks);
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (--m_busy == 0) { m_done.notify_one(); }
+    }
+  }
+}
+
+/*!
+ * Takes tasks of the current job until none is left.
+ * @param task The task of the current job.
+ * @param n_tasks Number of tasks in the current job.
+ */
+void ThreadPool::work(const std::function<void(size_t)>& task, size_t n_tasks) {
+  for (size_t i = m_next.fetch_add(1); i < n_tasks; i = m_next.fetch_add(1)) {
+    task(i);
+  }
+}
+
+/*!
+ * Runs task(i) for every i in [0, n_tasks), returning when all of them are done.
+ *
+ * Every worker must report back before a job is over, so no thread can
+ * still be looking at a job once the next one starts.
+ * @param n_tasks Number of tasks.
+ * @param task The task, called once with each index.
+ */
+void ThreadPool::run(size_t n_tasks, const std::function<void(size_t)>& task) {
+  /// Nothing to share, run everything on the calling thread.
+  if (m_workers.empty() || n_tasks <= 1) {
+    for (size_t i = 0; i < n_tasks; ++i) { task(i); }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_task = &task;
+    m_n_tasks = n_tasks;
+    m_next = 0;
+    m_busy = m_workers.size();
+    ++m_job;
+  }
+  m_wake.notify_all();
+
+  work(task, n_tasks);
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_done.wait(lock, [&] { return m_busy == 0; });
+  m_task = nullptr;
+}
+
+/*!
+ * Splits [begin, end) into one contiguous band per thread and runs body(first, last) on each.
+ * @param begin First index of the range.
+ * @param end One past the last index of the range.
+ * @param body Function that processes the indices in [first, last).
+ */
+void ThreadPool::for_each_band(size_t begin,
+                               size_t end,
+                               const std::function<void(size_t, size_t)>& body) {
+  /// The task only captures one reference, so std::function keeps it without allocating.
+  struct Bands {
+    size_t begin;
+    size_t length;
+    size_t count;
+    const std::function<void(size_t, size_t)>& body;
+  } bands{ begin, end > begin ? end - begin : 0, 0, body };
+  bands.count = std::min(size(), bands.length);
+
+  run(bands.count, [&bands](size_t band) {
+    bands.body(bands.begin + bands.length * band / bands.count,
+               bands.begin + bands.length * (band + 1) / bands.count);
+  });
+}
+
+}  // namespace life
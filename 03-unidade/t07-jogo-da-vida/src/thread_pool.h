@@ -0,0 +1,64 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace life {
+
+/*!
+ * A fixed set of worker threads that run the bands of a generation.
+ *
+ * The threads are created once and sleep between jobs, so stepping a
+ * generation in parallel does not pay for thread creation. The calling
+ * thread also takes part in every job, so a pool of size N owns N - 1
+ * worker threads.
+ */
+class ThreadPool {
+public:
+  //=== Special members
+  /// Constructor, starts the worker threads.
+  explicit ThreadPool(size_t n_threads = 1);
+  /// Destructor, stops and joins the worker threads.
+  ~ThreadPool();
+  /// A pool owns its threads, so it cannot be copied.
+  ThreadPool(const ThreadPool&) = delete;
+  /// A pool owns its threads, so it cannot be assigned.
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  //=== Members
+  /// Runs task(i) for every i in [0, n_tasks), returning when all of them are done.
+  void run(size_t n_tasks, const std::function<void(size_t)>& task);
+  /// Splits [begin, end) into one contiguous band per thread and runs body(first, last) on each.
+  void for_each_band(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body);
+
+  //=== Attribute accessors members.
+  /// Number of threads taking part in each job, the calling one included.
+  [[nodiscard]] size_t size() const { return m_workers.size() + 1; }
+
+private:
+  /// Main loop of a worker thread.
+  void worker_loop();
+  /// Takes tasks of the current job until none is left.
+  void work(const std::function<void(size_t)>& task, size_t n_tasks);
+
+  std::vector<std::thread> m_workers;           //!< Worker threads.
+  std::mutex m_mutex;                           //!< Guards the job description below.
+  std::condition_variable m_wake;               //!< Signals a new job (or the stop request).
+  std::condition_variable m_done;               //!< Signals that every worker left the job.
+  const std::function<void(size_t)>* m_task{ nullptr };  //!< Task of the current job.
+  size_t m_n_tasks{ 0 };                        //!< Number of tasks in the current job.
+  size_t m_job{ 0 };                            //!< Identifier of the current job.
+  size_t m_busy{ 0 };                           //!< Workers that did not finish the current job yet.
+  bool m_stop{ false };                         //!< Tells the workers to finish.
+  std::atomic<size_t> m_next{ 0 };             //!< Next task to be taken.
+};
+
+}  // namespace life
+
+#endif  // THREAD_POOL_H
@@ -0,0 +1,192 @@
+/*!
+ * TileBoard class implementation.
+ * @file tile_board.cpp
+ */
+
+#include "tile_board.h"
+
+#include <algorithm>
+
+#include "life.h"
+#include "thread_pool.h"
+
+namespace life {
+
+/*!
+ * Copies the alive cells of a board and marks every tile as active.
+ * @param cfg The board to be copied.
+ */
+void TileBoard::load(const LifeCfg& cfg) {
+  m_rows = cfg.m_rows;
+  m_cols = cfg.m_cols;
+  m_tile_rows = (m_rows + tile_size - 1) / tile_size;
+  m_tile_cols = (m_cols + tile_size - 1) / tile_size;
+
+  const size_t expanded_cols = m_cols + 2;
+  size_t population = 0;
+
+  m_cells.assign((m_rows + 2) * expanded_cols, 0);
+  for (size_t r = 1; r <= m_rows; ++r) {
+    for (size_t c = 1; c <= m_cols; ++c) {
+      if (cfg.get_cell(r, c).is_alive) {
+        m_cells[r * expanded_cols + c] = 1;
+        ++population;
+      }
+    }
+  }
+  m_next = m_cells;
+  m_population = population;
+
+  m_active.assign(m_tile_rows * m_tile_cols, 1);
+  m_changed.assign(m_tile_rows * m_tile_cols, 0);
+  m_dirty.assign(m_tile_rows * m_tile_cols, 0);
+}
+
+/*!
+ * Computes the next generation of the active tiles, splitting the rows of
+ * tiles among the threads of the pool, if there is one.
+ *
+ * The buffer that receives the next generation holds the previous one, so
+ * the tiles that are skipped already hold their (unchanged) next state.
+ * On a torus the ghost border holds the opposite edges while stepping; the
+ * population only counts the board, so the border is not killed afterwards.
+ */
+void TileBoard::step() {
+  if (m_topology == e_topology::TORUS) { wrap_border(m_cells.data(), m_rows, m_cols); }
+
+  with_rule(m_rule, [this](const auto& rule) {
+    if (m_pool != nullptr) {
+      m_pool->for_each_band(0, m_tile_rows, [this, &rule](size_t first, size_t last) {
+        step_tile_rows(first, last, rule);
+      });
+    } else {
+      step_tile_rows(0, m_tile_rows, rule);
+    }
+  });
+
+  m_cells.swap(m_next);
+  activate_changed();
+}
+
+/*!
+ * Computes the next generation of the active tiles in the tile rows [first, last).
+ * @param first First row of tiles.
+ * @param last One past the last row of tiles.
+ * @param rule Kernel rule of the simulation.
+ */
+template <typename KernelRule>
+void TileBoard::step_tile_rows(size_t first, size_t last, const KernelRule& rule) {
+  for (size_t tr = first; tr < last; ++tr) {
+    for (size_t tc = 0; tc < m_tile_cols; ++tc) {
+      const size_t tile = tr * m_tile_cols + tc;
+      m_changed[tile] = m_active[tile] ? step_tile(tr, tc, rule) : 0;
+    }
+  }
+}
+
+/*!
+ * Computes the next generation of a tile.
+ * @param tile_row Row of the tile.
+ * @param tile_col Column of the tile.
+ * @param rule Kernel rule of the simulation.
+ * @return true if any cell of the tile changed, false otherwise.
+ */
+template <typename KernelRule>
+bool TileBoard::step_tile(size_t tile_row, size_t tile_col, const KernelRule& rule) {
+  const size_t expanded_cols = m_cols + 2;
+  const size_t first_row = tile_row * tile_size + 1;
+  const size_t last_row = std::min(first_row + tile_size, m_rows + 1);
+  const size_t first_col = tile_col * tile_size + 1;
+  const size_t last_col = std::min(first_col + tile_size, m_cols + 1);
+
+  size_t births = 0;
+  size_t deaths = 0;
+
+  for (size_t r = first_row; r < last_row; ++r) {
+    const cell_t* up = m_cells.data() + (r - 1) * expanded_cols;
+    const cell_t* mid = m_cells.data() + r * expanded_cols;
+    const cell_t* down = m_cells.data() + (r + 1) * expanded_cols;
+    cell_t* out = m_next.data() + r * expanded_cols;
+
+    for (size_t c = first_col; c < last_col; ++c) {
+      const unsigned alive_neighbors = up[c - 1] + up[c] + up[c + 1] + mid[c - 1] + mid[c + 1]
+                                       + down[c - 1] + down[c] + down[c + 1];
+      const cell_t next = rule.table.next[mid[c]][alive_neighbors];
+
+      out[c] = next;
+      births += next & ~mid[c] & 1;
+      deaths += mid[c] & ~next & 1;
+    }
+  }
+
+  if (births != 0) { m_population += births; }
+  if (deaths != 0) { m_population -= deaths; }
+  return births != 0 || deaths != 0;
+}
+
+/*!
+ * Marks as active the tiles that changed in the last step and their neighbors.
+ * The changed tiles are also marked as dirty, to be written by the next store.
+ */
+void TileBoard::activate_changed() {
+  std::fill(m_active.begin(), m_active.end(), 0);
+
+  for (size_t tr = 0; tr < m_tile_rows; ++tr) {
+    for (size_t tc = 0; tc < m_tile_cols; ++tc) {
+      if (!m_changed[tr * m_tile_cols + tc]) { continue; }
+      m_dirty[tr * m_tile_cols + tc] = 1;
+
+      if (m_topology == e_topology::TORUS) {
+        /// The neighbors of an edge tile include the tiles of the opposite edge.
+        for (size_t i = tr + m_tile_rows - 1; i <= tr + m_tile_rows + 1; ++i) {
+          for (size_t j = tc + m_tile_cols - 1; j <= tc + m_tile_cols + 1; ++j) {
+            m_active[(i % m_tile_rows) * m_tile_cols + j % m_tile_cols] = 1;
+          }
+        }
+        continue;
+      }
+
+      const size_t first_row = tr > 0 ? tr - 1 : 0;
+      const size_t last_row = std::min(tr + 2, m_tile_rows);
+      const size_t first_col = tc > 0 ? tc - 1 : 0;
+      const size_t last_col = std::min(tc + 2, m_tile_cols);
+      for (size_t i = first_row; i < last_row; ++i) {
+        for (size_t j = first_col; j < last_col; ++j) { m_active[i * m_tile_cols + j] = 1; }
+      }
+    }
+  }
+}
+
+/*!
+ * Writes the tiles changed since the last store into the board cells.
+ * The board is expected to hold the generation of the last store.
+ * @param cfg The board that receives the current generation.
+ */
+void TileBoard::store(LifeCfg& cfg) {
+  const size_t expanded_cols = m_cols + 2;
+
+  for (size_t tr = 0; tr < m_tile_rows; ++tr) {
+    for (size_t tc = 0; tc < m_tile_cols; ++tc) {
+      if (!m_dirty[tr * m_tile_cols + tc]) { continue; }
+      m_dirty[tr * m_tile_cols + tc] = 0;
+
+      const size_t last_row = std::min((tr + 1) * tile_size, m_rows);
+      const size_t last_col = std::min((tc + 1) * tile_size, m_cols);
+      for (size_t r = tr * tile_size + 1; r <= last_row; ++r) {
+        for (size_t c = tc * tile_size + 1; c <= last_col; ++c) {
+          cfg.set_alive(r, c, m_cells[r * expanded_cols + c] != 0);
+        }
+      }
+    }
+  }
+}
+
+/*!
+ * Number of tiles that will be recomputed by the next step.
+ * @return The number of active tiles.
+ */
+size_t TileBoard::active_tiles() const {
+  return static_cast<size_t>(std::count(m_active.begin(), m_active.end(), 1));
+}
+
+}  // namespace life
@@ -0,0 +1,73 @@
+#ifndef TILE_BOARD_H
+#define TILE_BOARD_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "engine.h"
+
+namespace life {
+
+/*!
+ * Life board that only recomputes the regions where something happens.
+ *
+ * The board, one byte per cell with a dead ghost border, is split into
+ * square tiles of `tile_size` cells. A tile is recomputed only if it or one
+ * of its eight neighbor tiles changed in the previous generation; every
+ * other tile is known to stay the same. The number of alive cells is kept
+ * up to date with the births and deaths, so extinction is known at once.
+ */
+class TileBoard : public Engine {
+public:
+  //=== Alias
+  typedef uint8_t cell_t;  //!< Type of a cell, 1 if alive and 0 otherwise.
+  //=== Constants
+  static constexpr size_t tile_size = 16;  //!< Number of rows and columns of a tile.
+
+  //=== Special members
+  /// Constructor
+  TileBoard() = default;
+  /// Destructor
+  ~TileBoard() override = default;
+
+  //=== Engine interface.
+  /// Copies the alive cells of a board and marks every tile as active.
+  void load(const LifeCfg& cfg) override;
+  /// Computes the next generation of the active tiles.
+  void step() override;
+  /// Writes the tiles changed since the last store into the board cells.
+  void store(LifeCfg& cfg) override;
+  /// Number of alive cells, kept up to date while stepping.
+  [[nodiscard]] size_t population() const override { return m_population; }
+
+  //=== Attribute accessors members.
+  /// Number of tiles that will be recomputed by the next step.
+  [[nodiscard]] size_t active_tiles() const;
+
+private:
+  /// Computes the next generation of the active tiles in the tile rows [first, last).
+  template <typename KernelRule>
+  void step_tile_rows(size_t first, size_t last, const KernelRule& rule);
+  /// Computes the next generation of a tile, telling whether any of its cells changed.
+  template <typename KernelRule>
+  bool step_tile(size_t tile_row, size_t tile_col, const KernelRule& rule);
+  /// Marks as active (and dirty) the tiles that changed and their neighbors.
+  void activate_changed();
+
+  size_t m_rows{ 0 };                    //!< Number of rows in the game board.
+  size_t m_cols{ 0 };                    //!< Number of columns in the game board.
+  size_t m_tile_rows{ 0 };               //!< Number of rows of tiles.
+  size_t m_tile_cols{ 0 };               //!< Number of columns of tiles.
+  std::vector<cell_t> m_cells;           //!< Current generation, expanded board.
+  std::vector<cell_t> m_next;            //!< Previous generation, where the next one is computed.
+  std::vector<uint8_t> m_active;         //!< Tiles that must be recomputed in the next step.
+  std::vector<uint8_t> m_changed;        //!< Tiles that changed in the last step.
+  std::vector<uint8_t> m_dirty;          //!< Tiles that changed since the last store.
+  std::atomic<size_t> m_population{ 0 }; //!< Number of alive cells.
+};
+
+}  // namespace life
+
+#endif  // TILE_BOARD_H
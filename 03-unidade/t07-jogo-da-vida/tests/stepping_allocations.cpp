@@ -0,0 +1,133 @@
+/*!
+ * Checks that stepping a board allocates no memory once it is loaded.
+ * @file stepping_allocations.cpp
+ *
+ * The global operator new is replaced by one that counts its calls, so any
+ * allocation made while stepping is caught, whoever makes it. Each engine
+ * is loaded with a random board and stepped a number of generations, and
+ * both the counted allocations and LifeCfg::allocation_count() must stay
+ * the same across the generations.
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "life.h"
+
+namespace {
+std::atomic<size_t> allocations{ 0 };  //!< Calls to the global operator new.
+}  // namespace
+
+void* operator new(std::size_t size) {
+  ++allocations;
+  if (void* p = std::malloc(size == 0 ? 1 : size)) { return p; }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+using namespace life;
+
+namespace {
+
+/// An engine and the settings it is stepped with.
+struct EngineCase {
+  std::string engine;    //!< Name of the engine in glife.ini.
+  std::string topology;  //!< Topology of the board.
+  size_t threads;        //!< Threads that step each generation.
+};
+
+/*!
+ * Writes a copy of a configuration file with other values for some keys.
+ * @param base The configuration file copied.
+ * @param values The new value of each key.
+ * @return Name of the copy.
+ */
+std::string with_values(const std::string& base, const std::vector<std::pair<std::string, std::string>>& values) {
+  const auto settings = std::filesystem::temp_directory_path() / "glife_stepping_allocations.ini";
+  std::ifstream in(base);
+  std::ofstream out(settings);
+
+  for (std::string line; std::getline(in, line);) {
+    for (const auto& [key, value] : values) {
+      if (line.rfind(key + " ", 0) == 0 || line.rfind(key + "=", 0) == 0) { line = key + " = " + value; }
+    }
+    out << line << "\n";
+  }
+  return settings.string();
+}
+
+/*!
+ * Steps a random board with an engine, counting the allocations of each generation.
+ * @param test The engine and its settings.
+ * @param base Configuration file with the other settings.
+ * @return true if no generation allocated, false otherwise.
+ */
+bool check(const EngineCase& test, const std::string& base) {
+  const std::string settings = with_values(base, { { "engine", test.engine },
+                                                   { "threads", std::to_string(test.threads) },
+                                                   { "topology", test.topology },
+                                                   { "generate_image", "false" } });
+  Config conf;
+  conf.load(settings);
+  std::filesystem::remove(settings);
+
+  std::ostream silent(nullptr);
+  LifeCfg cfg(96, 96);
+  cfg.set_log(silent);
+
+  std::mt19937 random(96);
+  std::bernoulli_distribution alive(0.35);
+  for (size_t r = 1; r <= cfg.m_rows; ++r) {
+    for (size_t c = 1; c <= cfg.m_cols; ++c) { cfg.set_alive(r, c, alive(random)); }
+  }
+  cfg.set_threads(conf.get_threads());
+  cfg.set_engine(conf);
+
+  const size_t buffers = cfg.allocation_count();
+  size_t failures = 0;
+  for (size_t generation = 1; generation <= 200; ++generation) {
+    const size_t before = allocations.load();
+    cfg.update();
+    const size_t allocated = allocations.load() - before;
+    if (allocated != 0 && failures++ == 0) {
+      std::cerr << test.engine << "/" << test.topology << "/" << test.threads << ": " << allocated
+                << " allocation(s) in generation " << generation << std::endl;
+    }
+  }
+  if (cfg.allocation_count() != buffers) {
+    std::cerr << test.engine << "/" << test.topology << "/" << test.threads << ": "
+              << cfg.allocation_count() - buffers << " buffer(s) reallocated" << std::endl;
+    ++failures;
+  }
+  return failures == 0;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const std::string base = argc > 1 ? argv[1] : "config/glife.ini";
+
+  /// The plane grows its buffer while the pattern spreads, so it is left out.
+  const std::vector<EngineCase> cases = {
+    { "cell", "bounded", 1 },      { "cell", "bounded", 4 },   { "cell", "torus", 1 },
+    { "bitpacked", "bounded", 1 }, { "bitpacked", "torus", 4 }, { "sparse", "bounded", 1 },
+    { "simd", "bounded", 1 },      { "simd", "torus", 4 },
+  };
+
+  size_t failed = 0;
+  for (const auto& test : cases) {
+    if (!check(test, base)) { ++failed; }
+  }
+  std::cout << cases.size() - failed << " of " << cases.size() << " engines stepped without allocating." << std::endl;
+  return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -4,6 +4,8 @@
 
 #include "Level.h"
 
+#include <algorithm>
+
 /// Cell default constructor
 Cell::Cell(const size_t& line, const size_t& col, const e_content& content)
 : line(line), column(col), content(content) {}
@@ -26,7 +28,7 @@ size_t Cell::get_col() const {
 
 /// Level default constructor;
 Level::Level(const size_t &lines, const size_t &cols)
-: m_lines(lines), m_cols(cols){}
+: m_lines(lines), m_cols(cols), m_stride(cols + 2) {}
 
 void Level::set_lines(const size_t& value) {
     this->m_lines = value;
@@ -38,40 +40,73 @@ size_t Level::get_lines() const {
 
 void Level::set_cols(const size_t& value) {
     this->m_cols = value;
+    this->m_stride = value + 2;
 }
 
 size_t Level::get_cols() const {
     return this->m_cols;
 }
 
+/// Fills the level with empty cells, surrounded by a border of walls.
 void Level::fill_board() {
-    for (int i = 0; i < m_lines; ++i) {
-        for (int j = 0; j < m_cols; ++j) {
-            this->m_board.emplace_back(i, j, e_content::EMPTY);
+    const size_t size = (m_lines + 2) * m_stride;
+    this->m_board.assign(size, e_content::WALL);
+    this->m_passable.assign((size + 63) / 64, 0);
+    this->m_neighbor_offsets = { -1, 1, -static_cast<std::ptrdiff_t>(m_stride), static_cast<std::ptrdiff_t>(m_stride) };
+
+    for (size_t i = 0; i < m_lines; ++i) {
+        for (size_t j = 0; j < m_cols; ++j) {
+            this->set_content_at(index_of(i, j), e_content::EMPTY);
         }
     }
 }
 
-Cell& Level::get_cell(const size_t &r, const size_t &c) {
-    const size_t index = r * get_cols() + c;
-    return m_board[index];
+Cell Level::get_cell(const size_t &r, const size_t &c) const {
+    return Cell(r, c, m_board[index_of(r, c)]);
+}
+
+e_content Level::get_content(const size_t& r, const size_t& c) const {
+    return m_board[index_of(r, c)];
+}
+
+void Level::set_content(const size_t& r, const size_t& c, const e_content& content) {
+    this->set_content_at(index_of(r, c), content);
+}
+
+void Level::set_content_at(const size_t& index, const e_content& content) {
+    this->m_board[index] = content;
+    const std::uint64_t bit = std::uint64_t{ 1 } << (index & 63);
+    if (content == e_content::EMPTY || content == e_content::FOOD) {
+        this->m_passable[index >> 6] |= bit;
+    } else {
+        this->m_passable[index >> 6] &= ~bit;
+    }
 }
 
 void Level::update_line_from_text(const std::string &text, const size_t& line, const size_t& max_cols) {
+    /// Characters past the size of the level would land on the border or the next line.
+    if (line >= m_lines) {
+        this->set_invalid();
+        return;
+    }
+    const size_t cols = std::min(max_cols, m_cols);
     size_t col = 0;
     for (const auto& c : text) {
+        if (col >= cols) {
+            break;
+        }
         switch (c) {
             case '#':
-                this->get_cell(line, col).set_content(e_content::WALL);
+                this->set_content(line, col, e_content::WALL);
                 break;
             case '&':
-                this->get_cell(line, col).set_content(e_content::SNAKE_HEAD);
+                this->set_content(line, col, e_content::SNAKE_HEAD);
                 break;
             case '.':
-                this->get_cell(line,col).set_content(e_content::INVISIBLE_WALL);
+                this->set_content(line, col, e_content::INVISIBLE_WALL);
                 break;
             case ' ':
-                this->get_cell(line, col).set_content(e_content::EMPTY);
+                this->set_content(line, col, e_content::EMPTY);
                 break;
             default:
                 this->set_invalid();
@@ -87,6 +122,7 @@ void Level::set_invalid() {
 
 void Level::clear_board() {
     this->m_board.clear();
+    this->m_passable.clear();
 }
 
 bool Level::is_valid() const {
@@ -95,43 +131,51 @@ bool Level::is_valid() const {
 
 // TODO: EDIT METHOD, CURRENT VERSION FOR TEST PURPOSES.
 std::string Level::to_string() {
-    std::ostringstream oss;
+    std::string str;
+    str.reserve(m_lines * (m_cols + 1));
     for (size_t i = 0; i < m_lines; ++i) {
-        for (size_t j = 0; j < m_cols; ++j) {
-            if (get_cell(i, j).get_content() == e_content::WALL) {
-                oss << "#";
-            } else if (get_cell(i, j).get_content() == e_content::EMPTY ||
-                get_cell(i, j).get_content() == e_content::INVISIBLE_WALL) {
-                oss << " ";
-            } else if (get_cell(i, j).get_content() == e_content::FOOD) {
-                oss << "F";
-            }
-            else {
-                oss << "S";
+        for (size_t index = index_of(i, 0); index < index_of(i, m_cols); ++index) {
+            switch (m_board[index]) {
+                case e_content::WALL:
+                    str += '#';
+                    break;
+                case e_content::EMPTY:
+                case e_content::INVISIBLE_WALL:
+                    str += ' ';
+                    break;
+                case e_content::FOOD:
+                    str += 'F';
+                    break;
+                default:
+                    str += 'S';
+                    break;
             }
         }
-        oss << "\n";
+        str += '\n';
     }
-    return oss.str();
+    return str;
 }
 
+/// Places food on a random empty cell, if there is one.
 void Level::generate_food() {
-    std::vector<Cell> empty_cells;
-
-    for (auto& cell : this->m_board) {
-        if (cell.get_content() == e_content::EMPTY) {
-            empty_cells.push_back(cell);
-        }
+    size_t empty_cells = 0;
+    for (const auto& content : this->m_board) {
+        empty_cells += content == e_content::EMPTY;
+    }
+    if (empty_cells == 0) {
+        return;
     }
 
     std::random_device rd;
     std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, empty_cells.size() - 1);
-    const size_t random_index = dis(gen);
-
-    const size_t line_to_update = empty_cells[random_index].get_line();
-    const size_t col_to_update = empty_cells[random_index].get_line();
-    this->get_cell(line_to_update, col_to_update).set_content(e_content::FOOD);
+    std::uniform_int_distribution<size_t> dis(0, empty_cells - 1);
+    size_t remaining = dis(gen);
+
+    /// The border is all walls, so every empty index is inside the level.
+    for (size_t index = 0; index < m_board.size(); ++index) {
+        if (m_board[index] == e_content::EMPTY && remaining-- == 0) {
+            this->set_content_at(index, e_content::FOOD);
+            return;
+        }
+    }
 }
-
-
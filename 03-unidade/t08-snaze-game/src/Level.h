@@ -5,13 +5,16 @@
 #ifndef LEVEL_H
 #define LEVEL_H
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <sstream>
 #include <random>
 
-enum class e_content {
+/// Content of a cell, one byte per cell in the board of a level.
+enum class e_content : std::uint8_t {
     EMPTY = 0,
     WALL,
     INVISIBLE_WALL,
@@ -34,12 +37,25 @@ public:
     [[nodiscard]] size_t get_col() const;
 };
 
+/*!
+ * The board is stored as a struct of arrays: one byte of content per cell, in
+ * row-major order, plus a bitset of the cells the snake can enter (empty or
+ * with food). The board is padded with a border of walls, so the neighbors of
+ * any cell are found by adding neighbor_offsets() to its index, without
+ * checking the bounds; lines and columns are derived from the index.
+ */
 class Level {
     size_t m_lines { 10 };
     size_t m_cols { 10 };
-    std::vector<Cell> m_board;
+    size_t m_stride { 12 };                           //!< Cells of a padded line: the columns and two walls.
+    std::vector<e_content> m_board;                   //!< Content of each cell, border of walls included.
+    std::vector<std::uint64_t> m_passable;            //!< Bit of each cell the snake can enter, by index.
+    std::array<std::ptrdiff_t, 4> m_neighbor_offsets {};  //!< Index offsets to the left, right, up and down neighbors.
     bool valid { true };
 
+    /// Updates the content and the passable bit of a cell.
+    void set_content_at(const size_t& index, const e_content& content);
+
 public:
     /// Default constructor with arguments.
     explicit Level(const size_t& lines = 10, const size_t& cols = 10);
@@ -48,7 +64,26 @@ public:
     void set_cols(const size_t& value);
     [[nodiscard]] size_t get_cols() const;
     void fill_board();
-    Cell& get_cell(const size_t& r, const size_t& c);
+    /// Returns a copy of a cell; the level is changed through set_content().
+    [[nodiscard]] Cell get_cell(const size_t& r, const size_t& c) const;
+    [[nodiscard]] e_content get_content(const size_t& r, const size_t& c) const;
+    void set_content(const size_t& r, const size_t& c, const e_content& content);
+
+    //=== Index access, for the searches that scan the board.
+    /// Index of the cell at a line and column.
+    [[nodiscard]] size_t index_of(const size_t& r, const size_t& c) const { return (r + 1) * m_stride + c + 1; }
+    /// Line of the cell at an index.
+    [[nodiscard]] size_t line_of(const size_t& index) const { return index / m_stride - 1; }
+    /// Column of the cell at an index.
+    [[nodiscard]] size_t col_of(const size_t& index) const { return index % m_stride - 1; }
+    /// Content of the cell at an index.
+    [[nodiscard]] e_content content_at(const size_t& index) const { return m_board[index]; }
+    /// Whether the snake can enter the cell at an index.
+    [[nodiscard]] bool is_passable(const size_t& index) const { return (m_passable[index >> 6] >> (index & 63)) & 1U; }
+    /// Index offsets to the left, right, up and down neighbors of a cell.
+    [[nodiscard]] const std::array<std::ptrdiff_t, 4>& neighbor_offsets() const { return m_neighbor_offsets; }
+    /// Bitset of the cells the snake can enter, by index.
+    [[nodiscard]] const std::vector<std::uint64_t>& passable() const { return m_passable; }
 
     void update_line_from_text(const std::string& text, const size_t& line, const size_t& max_cols);
     void set_invalid();